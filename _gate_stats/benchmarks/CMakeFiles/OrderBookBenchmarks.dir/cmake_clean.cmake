@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/OrderBookBenchmarks.dir/OrderBookBenchmarks.cpp.o"
+  "CMakeFiles/OrderBookBenchmarks.dir/OrderBookBenchmarks.cpp.o.d"
+  "OrderBookBenchmarks"
+  "OrderBookBenchmarks.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/OrderBookBenchmarks.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
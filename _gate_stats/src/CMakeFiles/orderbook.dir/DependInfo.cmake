@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/CommandJournal.cpp" "src/CMakeFiles/orderbook.dir/CommandJournal.cpp.o" "gcc" "src/CMakeFiles/orderbook.dir/CommandJournal.cpp.o.d"
+  "/root/repo/src/HugePageResource.cpp" "src/CMakeFiles/orderbook.dir/HugePageResource.cpp.o" "gcc" "src/CMakeFiles/orderbook.dir/HugePageResource.cpp.o.d"
+  "/root/repo/src/OrderBook.cpp" "src/CMakeFiles/orderbook.dir/OrderBook.cpp.o" "gcc" "src/CMakeFiles/orderbook.dir/OrderBook.cpp.o.d"
+  "/root/repo/src/OrderBookEngine.cpp" "src/CMakeFiles/orderbook.dir/OrderBookEngine.cpp.o" "gcc" "src/CMakeFiles/orderbook.dir/OrderBookEngine.cpp.o.d"
+  "/root/repo/src/OrderBookStats.cpp" "src/CMakeFiles/orderbook.dir/OrderBookStats.cpp.o" "gcc" "src/CMakeFiles/orderbook.dir/OrderBookStats.cpp.o.d"
+  "/root/repo/src/OrderFlowReplayer.cpp" "src/CMakeFiles/orderbook.dir/OrderFlowReplayer.cpp.o" "gcc" "src/CMakeFiles/orderbook.dir/OrderFlowReplayer.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
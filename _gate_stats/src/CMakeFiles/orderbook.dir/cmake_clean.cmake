@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/orderbook.dir/CommandJournal.cpp.o"
+  "CMakeFiles/orderbook.dir/CommandJournal.cpp.o.d"
+  "CMakeFiles/orderbook.dir/HugePageResource.cpp.o"
+  "CMakeFiles/orderbook.dir/HugePageResource.cpp.o.d"
+  "CMakeFiles/orderbook.dir/OrderBook.cpp.o"
+  "CMakeFiles/orderbook.dir/OrderBook.cpp.o.d"
+  "CMakeFiles/orderbook.dir/OrderBookEngine.cpp.o"
+  "CMakeFiles/orderbook.dir/OrderBookEngine.cpp.o.d"
+  "CMakeFiles/orderbook.dir/OrderBookStats.cpp.o"
+  "CMakeFiles/orderbook.dir/OrderBookStats.cpp.o.d"
+  "CMakeFiles/orderbook.dir/OrderFlowReplayer.cpp.o"
+  "CMakeFiles/orderbook.dir/OrderFlowReplayer.cpp.o.d"
+  "liborderbook.a"
+  "liborderbook.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/orderbook.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/OrderFlowReplay.dir/OrderFlowReplay.cpp.o"
+  "CMakeFiles/OrderFlowReplay.dir/OrderFlowReplay.cpp.o.d"
+  "OrderFlowReplay"
+  "OrderFlowReplay.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/OrderFlowReplay.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,35 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/unit_tests/CommandJournalTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/CommandJournalTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/CommandJournalTests.cpp.o.d"
+  "/root/repo/unit_tests/DepthPublisherTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/DepthPublisherTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/DepthPublisherTests.cpp.o.d"
+  "/root/repo/unit_tests/HugePageResourceTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/HugePageResourceTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/HugePageResourceTests.cpp.o.d"
+  "/root/repo/unit_tests/NodeArenaTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/NodeArenaTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/NodeArenaTests.cpp.o.d"
+  "/root/repo/unit_tests/OccupancyBitmapTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/OccupancyBitmapTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/OccupancyBitmapTests.cpp.o.d"
+  "/root/repo/unit_tests/OrderBookEngineTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/OrderBookEngineTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/OrderBookEngineTests.cpp.o.d"
+  "/root/repo/unit_tests/OrderBookStatsTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/OrderBookStatsTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/OrderBookStatsTests.cpp.o.d"
+  "/root/repo/unit_tests/OrderBookTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/OrderBookTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/OrderBookTests.cpp.o.d"
+  "/root/repo/unit_tests/OrderFlowReplayerTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/OrderFlowReplayerTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/OrderFlowReplayerTests.cpp.o.d"
+  "/root/repo/unit_tests/OrderIndexTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/OrderIndexTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/OrderIndexTests.cpp.o.d"
+  "/root/repo/unit_tests/QueuePositionIndexTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/QueuePositionIndexTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/QueuePositionIndexTests.cpp.o.d"
+  "/root/repo/unit_tests/SpscRingBufferTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/SpscRingBufferTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/SpscRingBufferTests.cpp.o.d"
+  "/root/repo/unit_tests/TradeAnalyticsTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/TradeAnalyticsTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/TradeAnalyticsTests.cpp.o.d"
+  "/root/repo/unit_tests/UniqueIDGeneratorTests.cpp" "unit_tests/CMakeFiles/OrderBookTests.dir/UniqueIDGeneratorTests.cpp.o" "gcc" "unit_tests/CMakeFiles/OrderBookTests.dir/UniqueIDGeneratorTests.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_stats/src/CMakeFiles/orderbook.dir/DependInfo.cmake"
+  "/root/repo/_gate_stats/_deps/googletest-build/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/_gate_stats/_deps/googletest-build/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
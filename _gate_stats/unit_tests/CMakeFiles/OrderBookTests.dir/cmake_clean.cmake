@@ -0,0 +1,38 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/OrderBookTests.dir/CommandJournalTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/CommandJournalTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/DepthPublisherTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/DepthPublisherTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/HugePageResourceTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/HugePageResourceTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/NodeArenaTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/NodeArenaTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/OccupancyBitmapTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/OccupancyBitmapTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/OrderBookEngineTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/OrderBookEngineTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/OrderBookStatsTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/OrderBookStatsTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/OrderBookTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/OrderBookTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/OrderFlowReplayerTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/OrderFlowReplayerTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/OrderIndexTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/OrderIndexTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/QueuePositionIndexTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/QueuePositionIndexTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/SpscRingBufferTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/SpscRingBufferTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/TradeAnalyticsTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/TradeAnalyticsTests.cpp.o.d"
+  "CMakeFiles/OrderBookTests.dir/UniqueIDGeneratorTests.cpp.o"
+  "CMakeFiles/OrderBookTests.dir/UniqueIDGeneratorTests.cpp.o.d"
+  "OrderBookTests"
+  "OrderBookTests.pdb"
+  "OrderBookTests[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/OrderBookTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/unit_tests
+# Build directory: /root/repo/_gate_stats/unit_tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_gate_stats/unit_tests/OrderBookTests[1]_include.cmake")
+subdirs("../_deps/googletest-build")
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_gate_stats/unit_tests/OrderBookTests[1]_tests.cmake")
+  include("/root/repo/_gate_stats/unit_tests/OrderBookTests[1]_tests.cmake")
+else()
+  add_test(OrderBookTests_NOT_BUILT OrderBookTests_NOT_BUILT)
+endif()
@@ -0,0 +1,131 @@
+add_test([=[CommandJournalTests.ReplayRebuildsOrderBook]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=CommandJournalTests.ReplayRebuildsOrderBook]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CommandJournalTests.ReplayRebuildsOrderBook]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CommandJournalTests.ReplayKeepsOwnersRepricesAndTimeInForce]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=CommandJournalTests.ReplayKeepsOwnersRepricesAndTimeInForce]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CommandJournalTests.ReplayKeepsOwnersRepricesAndTimeInForce]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CommandJournalTests.AppendAfterTornRecord]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=CommandJournalTests.AppendAfterTornRecord]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CommandJournalTests.AppendAfterTornRecord]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CommandJournalTests.ReadsVersionOneAndRejectsNewerVersions]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=CommandJournalTests.ReadsVersionOneAndRejectsNewerVersions]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CommandJournalTests.ReadsVersionOneAndRejectsNewerVersions]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[DepthPublisherTests.PublishAndRead]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=DepthPublisherTests.PublishAndRead]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[DepthPublisherTests.PublishAndRead]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[DepthPublisherTests.OrderBookPublishesTopLevels]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=DepthPublisherTests.OrderBookPublishesTopLevels]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[DepthPublisherTests.OrderBookPublishesTopLevels]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[DepthPublisherTests.ReadersOnlySeeConsistentSnapshots]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=DepthPublisherTests.ReadersOnlySeeConsistentSnapshots]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[DepthPublisherTests.ReadersOnlySeeConsistentSnapshots]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[HugePageResourceTests.CarvesBlocksOffTheRegion]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=HugePageResourceTests.CarvesBlocksOffTheRegion]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[HugePageResourceTests.CarvesBlocksOffTheRegion]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[HugePageResourceTests.ReservedOrderBookDoesNotGrow]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=HugePageResourceTests.ReservedOrderBookDoesNotGrow]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[HugePageResourceTests.ReservedOrderBookDoesNotGrow]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[NodeArenaTests.RecyclesBlocksPerSizeClass]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=NodeArenaTests.RecyclesBlocksPerSizeClass]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[NodeArenaTests.RecyclesBlocksPerSizeClass]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[NodeArenaTests.GrowsByDoublingChunks]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=NodeArenaTests.GrowsByDoublingChunks]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[NodeArenaTests.GrowsByDoublingChunks]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[NodeArenaTests.ReserveTakesMemoryUpFront]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=NodeArenaTests.ReserveTakesMemoryUpFront]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[NodeArenaTests.ReserveTakesMemoryUpFront]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OccupancyBitmapTests.NextAndPrevAcrossWordsAndSummaries]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OccupancyBitmapTests.NextAndPrevAcrossWordsAndSummaries]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OccupancyBitmapTests.NextAndPrevAcrossWordsAndSummaries]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OccupancyBitmapTests.MatchesOrderedSet]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OccupancyBitmapTests.MatchesOrderedSet]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OccupancyBitmapTests.MatchesOrderedSet]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookEngineTests.SymbolsAreProcessedOnTheirShards]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookEngineTests.SymbolsAreProcessedOnTheirShards]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookEngineTests.SymbolsAreProcessedOnTheirShards]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookEngineTests.ManySymbolsAcrossShards]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookEngineTests.ManySymbolsAcrossShards]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookEngineTests.ManySymbolsAcrossShards]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookEngineTests.TradesDroppedWhileStoppingAreCounted]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookEngineTests.TradesDroppedWhileStoppingAreCounted]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookEngineTests.TradesDroppedWhileStoppingAreCounted]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookStatsTests.HistogramPercentiles]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookStatsTests.HistogramPercentiles]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookStatsTests.HistogramPercentiles]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookStatsTests.Counters]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookStatsTests.Counters]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookStatsTests.Counters]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookStatsTests.OrderBookRecordsStats]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookStatsTests.OrderBookRecordsStats]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookStatsTests.OrderBookRecordsStats]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.SimpleInsert]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.SimpleInsert]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.SimpleInsert]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.SimpleMatchWithAggressiveSell]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.SimpleMatchWithAggressiveSell]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.SimpleMatchWithAggressiveSell]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.SimpleMatchWithAggressiveBuy]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.SimpleMatchWithAggressiveBuy]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.SimpleMatchWithAggressiveBuy]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.SingleSymbolMultiInsertAndMultiMatch]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.SingleSymbolMultiInsertAndMultiMatch]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.SingleSymbolMultiInsertAndMultiMatch]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.MultiSymbolMultiInsertAndMultiMatch]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.MultiSymbolMultiInsertAndMultiMatch]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.MultiSymbolMultiInsertAndMultiMatch]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.InsertAndAmend]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.InsertAndAmend]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.InsertAndAmend]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.TradeCorrectlyLoosesPricePriority]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.TradeCorrectlyLoosesPricePriority]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.TradeCorrectlyLoosesPricePriority]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.TickLadderMatchesAcrossLevels]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.TickLadderMatchesAcrossLevels]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.TickLadderMatchesAcrossLevels]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.TickLadderRejectsPricesOffTickAndOutsideBand]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.TickLadderRejectsPricesOffTickAndOutsideBand]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.TickLadderRejectsPricesOffTickAndOutsideBand]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.AmendUsesVolumeRemainingAfterPartialMatch]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.AmendUsesVolumeRemainingAfterPartialMatch]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.AmendUsesVolumeRemainingAfterPartialMatch]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.TopOfBookAndDepth]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.TopOfBookAndDepth]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.TopOfBookAndDepth]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.LevelDeltasAreCoalescedPerOperation]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.LevelDeltasAreCoalescedPerOperation]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.LevelDeltasAreCoalescedPerOperation]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.SnapshotRestoresRestingOrdersAndPriority]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.SnapshotRestoresRestingOrdersAndPriority]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.SnapshotRestoresRestingOrdersAndPriority]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.SnapshotRejectsCorruptRecords]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.SnapshotRejectsCorruptRecords]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.SnapshotRejectsCorruptRecords]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.ApplyBatchMatchesSequentialApply]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.ApplyBatchMatchesSequentialApply]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.ApplyBatchMatchesSequentialApply]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.AuctionUncrossesAtSingleClearingPrice]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.AuctionUncrossesAtSingleClearingPrice]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.AuctionUncrossesAtSingleClearingPrice]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.ResetReleasesArena]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.ResetReleasesArena]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.ResetReleasesArena]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.MassCancelByOwnerRangeAndSide]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.MassCancelByOwnerRangeAndSide]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.MassCancelByOwnerRangeAndSide]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.RepriceMovesOrdersAndMatchesOnce]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.RepriceMovesOrdersAndMatchesOnce]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.RepriceMovesOrdersAndMatchesOnce]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.CrossingRepricePublishesEachLevelOnce]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.CrossingRepricePublishesEachLevelOnce]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.CrossingRepricePublishesEachLevelOnce]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.ImmediateOrdersNeverRest]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.ImmediateOrdersNeverRest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.ImmediateOrdersNeverRest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.ImmediateOrderTradesLikeInsertAndPull]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.ImmediateOrderTradesLikeInsertAndPull]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.ImmediateOrderTradesLikeInsertAndPull]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.CustomTraitsWithIntegerTicks]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.CustomTraitsWithIntegerTicks]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.CustomTraitsWithIntegerTicks]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.NarrowSequenceIsRenumberedWhenItRunsOut]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.NarrowSequenceIsRenumberedWhenItRunsOut]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.NarrowSequenceIsRenumberedWhenItRunsOut]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.MemoryUsage]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.MemoryUsage]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.MemoryUsage]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.QueuePositionAndLevelOrders]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.QueuePositionAndLevelOrders]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.QueuePositionAndLevelOrders]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.QueuePositionsMatchTheOrdersAhead]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.QueuePositionsMatchTheOrdersAhead]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.QueuePositionsMatchTheOrdersAhead]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderBookTests.TradeSummaryAndBars]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderBookTests.TradeSummaryAndBars]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderBookTests.TradeSummaryAndBars]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderFlowReplayerTests.ReplaysReadmeExample]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderFlowReplayerTests.ReplaysReadmeExample]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderFlowReplayerTests.ReplaysReadmeExample]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderFlowReplayerTests.ParallelReplayMatchesSequentialApply]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderFlowReplayerTests.ParallelReplayMatchesSequentialApply]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderFlowReplayerTests.ParallelReplayMatchesSequentialApply]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderFlowReplayerTests.MalformedCaptureThrows]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderFlowReplayerTests.MalformedCaptureThrows]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderFlowReplayerTests.MalformedCaptureThrows]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderFlowReplayerTests.SkipsLeadingHeaderLine]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderFlowReplayerTests.SkipsLeadingHeaderLine]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderFlowReplayerTests.SkipsLeadingHeaderLine]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderIndexTests.InsertFindErase]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderIndexTests.InsertFindErase]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderIndexTests.InsertFindErase]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderIndexTests.ReserveAvoidsRehash]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderIndexTests.ReserveAvoidsRehash]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderIndexTests.ReserveAvoidsRehash]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[OrderIndexTests.MatchesUnorderedMapUnderChurn]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=OrderIndexTests.MatchesUnorderedMapUnderChurn]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[OrderIndexTests.MatchesUnorderedMapUnderChurn]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[QueuePositionIndexTests.AppendReduceRemove]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=QueuePositionIndexTests.AppendReduceRemove]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[QueuePositionIndexTests.AppendReduceRemove]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[QueuePositionIndexTests.MatchesPrefixSums]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=QueuePositionIndexTests.MatchesPrefixSums]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[QueuePositionIndexTests.MatchesPrefixSums]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SpscRingBufferTests.PushPopAndFull]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=SpscRingBufferTests.PushPopAndFull]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SpscRingBufferTests.PushPopAndFull]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SpscRingBufferTests.TradesStreamToConsumerThread]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=SpscRingBufferTests.TradesStreamToConsumerThread]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SpscRingBufferTests.TradesStreamToConsumerThread]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradeAnalyticsTests.Totals]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=TradeAnalyticsTests.Totals]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradeAnalyticsTests.Totals]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradeAnalyticsTests.BarsWrapAround]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=TradeAnalyticsTests.BarsWrapAround]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradeAnalyticsTests.BarsWrapAround]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[UniqueIDGeneratorTests.CounterHasItsOwnCacheLine]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=UniqueIDGeneratorTests.CounterHasItsOwnCacheLine]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UniqueIDGeneratorTests.CounterHasItsOwnCacheLine]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[UniqueIDGeneratorTests.LeasesHandOutUniqueIDsAcrossThreads]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=UniqueIDGeneratorTests.LeasesHandOutUniqueIDsAcrossThreads]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UniqueIDGeneratorTests.LeasesHandOutUniqueIDsAcrossThreads]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[UniqueIDGeneratorTests.ResetNeverRepeatsLeasedIDs]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=UniqueIDGeneratorTests.ResetNeverRepeatsLeasedIDs]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UniqueIDGeneratorTests.ResetNeverRepeatsLeasedIDs]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[UniqueIDGeneratorTests.OrderBookTradeIDBlocks]=]  /root/repo/_gate_stats/unit_tests/OrderBookTests [==[--gtest_filter=UniqueIDGeneratorTests.OrderBookTradeIDBlocks]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[UniqueIDGeneratorTests.OrderBookTradeIDBlocks]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_gate_stats/unit_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  OrderBookTests_TESTS CommandJournalTests.ReplayRebuildsOrderBook CommandJournalTests.ReplayKeepsOwnersRepricesAndTimeInForce CommandJournalTests.AppendAfterTornRecord CommandJournalTests.ReadsVersionOneAndRejectsNewerVersions DepthPublisherTests.PublishAndRead DepthPublisherTests.OrderBookPublishesTopLevels DepthPublisherTests.ReadersOnlySeeConsistentSnapshots HugePageResourceTests.CarvesBlocksOffTheRegion HugePageResourceTests.ReservedOrderBookDoesNotGrow NodeArenaTests.RecyclesBlocksPerSizeClass NodeArenaTests.GrowsByDoublingChunks NodeArenaTests.ReserveTakesMemoryUpFront OccupancyBitmapTests.NextAndPrevAcrossWordsAndSummaries OccupancyBitmapTests.MatchesOrderedSet OrderBookEngineTests.SymbolsAreProcessedOnTheirShards OrderBookEngineTests.ManySymbolsAcrossShards OrderBookEngineTests.TradesDroppedWhileStoppingAreCounted OrderBookStatsTests.HistogramPercentiles OrderBookStatsTests.Counters OrderBookStatsTests.OrderBookRecordsStats OrderBookTests.SimpleInsert OrderBookTests.SimpleMatchWithAggressiveSell OrderBookTests.SimpleMatchWithAggressiveBuy OrderBookTests.SingleSymbolMultiInsertAndMultiMatch OrderBookTests.MultiSymbolMultiInsertAndMultiMatch OrderBookTests.InsertAndAmend OrderBookTests.TradeCorrectlyLoosesPricePriority OrderBookTests.TickLadderMatchesAcrossLevels OrderBookTests.TickLadderRejectsPricesOffTickAndOutsideBand OrderBookTests.AmendUsesVolumeRemainingAfterPartialMatch OrderBookTests.TopOfBookAndDepth OrderBookTests.LevelDeltasAreCoalescedPerOperation OrderBookTests.SnapshotRestoresRestingOrdersAndPriority OrderBookTests.SnapshotRejectsCorruptRecords OrderBookTests.ApplyBatchMatchesSequentialApply OrderBookTests.AuctionUncrossesAtSingleClearingPrice OrderBookTests.ResetReleasesArena OrderBookTests.MassCancelByOwnerRangeAndSide OrderBookTests.RepriceMovesOrdersAndMatchesOnce OrderBookTests.CrossingRepricePublishesEachLevelOnce OrderBookTests.ImmediateOrdersNeverRest OrderBookTests.ImmediateOrderTradesLikeInsertAndPull OrderBookTests.CustomTraitsWithIntegerTicks OrderBookTests.NarrowSequenceIsRenumberedWhenItRunsOut OrderBookTests.MemoryUsage OrderBookTests.QueuePositionAndLevelOrders OrderBookTests.QueuePositionsMatchTheOrdersAhead OrderBookTests.TradeSummaryAndBars OrderFlowReplayerTests.ReplaysReadmeExample OrderFlowReplayerTests.ParallelReplayMatchesSequentialApply OrderFlowReplayerTests.MalformedCaptureThrows OrderFlowReplayerTests.SkipsLeadingHeaderLine OrderIndexTests.InsertFindErase OrderIndexTests.ReserveAvoidsRehash OrderIndexTests.MatchesUnorderedMapUnderChurn QueuePositionIndexTests.AppendReduceRemove QueuePositionIndexTests.MatchesPrefixSums SpscRingBufferTests.PushPopAndFull SpscRingBufferTests.TradesStreamToConsumerThread TradeAnalyticsTests.Totals TradeAnalyticsTests.BarsWrapAround UniqueIDGeneratorTests.CounterHasItsOwnCacheLine UniqueIDGeneratorTests.LeasesHandOutUniqueIDsAcrossThreads UniqueIDGeneratorTests.ResetNeverRepeatsLeasedIDs UniqueIDGeneratorTests.OrderBookTradeIDBlocks)
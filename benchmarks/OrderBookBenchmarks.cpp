@@ -0,0 +1,532 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "HugePageResource.h"
+#include "OrderBook.h"
+#include "OrderBookImpl.h"
+#include "OrderFlowGenerator.h"
+#include "UniqueIDGenerator.h"
+
+/*
+ * All benchmarks take the price level container as their first argument:
+ * 0 = 'std::map' levels (default constructor), 1 = flat array levels (tick size and price band).
+ */
+
+namespace
+{
+    constexpr double kMid  = 100.0;
+    constexpr double kTick = 0.01;
+
+
+    /**
+     * @brief 'OrderBook' which keeps a queue position index, see 'GetQueuePosition()'.
+     */
+    struct QueuePositionTraits : DefaultOrderBookTraits
+    {
+        using QueuePositions = QueuePositionIndex;
+    };
+
+    using QueuePositionOrderBook = BasicOrderBook< QueuePositionTraits >;
+
+
+    template< class Book = OrderBook >
+    std::unique_ptr<Book> MakeBook( const benchmark::State& state, UniqueIDGenerator& id_gen )
+    {
+        if( 0 == state.range(0) )
+        {
+            return std::make_unique<Book>( "BENCH", id_gen );
+        }
+
+        return std::make_unique<Book>( "BENCH", id_gen, kTick, kMid / 2, kMid * 2 );
+    }
+
+
+    /**
+     * @brief Price 'distance' ticks away from the mid on the passive side of 'side'.
+     */
+    double PassivePrice( const OrderBook::Side side, const size_t distance )
+    {
+        const double ticks = double( distance + 1 ) * ( OrderBook::Side::BUY == side ? -1.0 : 1.0 );
+        return kMid + ticks * kTick;
+    }
+
+
+    /**
+     * @brief Fills both sides of 'book' with 'levels' levels of 'orders_per_level' orders of volume 'vol'.
+     *        Order ids start at 1 and alternate between buy (odd) and sell (even).
+     */
+    void FillBook( OrderBook& book, const size_t levels, const size_t orders_per_level, const size_t vol = 10 )
+    {
+        size_t id = 1;
+        for( size_t level = 0; level < levels; ++level )
+        {
+            for( size_t i = 0; i < orders_per_level; ++i )
+            {
+                book.Insert( id++, OrderBook::Side::BUY,  PassivePrice( OrderBook::Side::BUY,  level ), vol );
+                book.Insert( id++, OrderBook::Side::SELL, PassivePrice( OrderBook::Side::SELL, level ), vol );
+            }
+        }
+    }
+
+
+    /**
+     * @brief Returns the value at 'percentile' (0-100) of 'samples'. Reorders 'samples'.
+     */
+    double Percentile( std::vector<uint64_t>& samples, const double percentile )
+    {
+        if( samples.empty() ) { return 0.0; }
+
+        const size_t index = std::min( samples.size() - 1, size_t( percentile / 100.0 * double(samples.size()) ) );
+        std::nth_element( samples.begin(), samples.begin() + std::ptrdiff_t(index), samples.end() );
+        return double( samples[index] );
+    }
+
+
+    void ReportLatency( benchmark::State& state, const std::string& name, std::vector<uint64_t>& samples )
+    {
+        state.counters[ name + "_p50_ns"  ] = Percentile( samples, 50.0 );
+        state.counters[ name + "_p99_ns"  ] = Percentile( samples, 99.0 );
+        state.counters[ name + "_p999_ns" ] = Percentile( samples, 99.9 );
+        state.counters[ name + "_max_ns"  ] = Percentile( samples, 100.0 );
+    }
+}
+
+
+static void BM_InsertPassive( benchmark::State& state )
+{
+    const size_t batch = size_t( state.range(1) );
+
+    for( auto _ : state )
+    {
+        state.PauseTiming();
+        UniqueIDGenerator id_gen;
+        auto book = MakeBook( state, id_gen );
+        state.ResumeTiming();
+
+        for( size_t i = 0; i < batch; ++i )
+        {
+            const OrderBook::Side side = i % 2 ? OrderBook::Side::BUY : OrderBook::Side::SELL;
+            book->Insert( i, side, PassivePrice( side, i % 50 ), 10 );
+        }
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed( state.iterations() * int64_t(batch) );
+}
+BENCHMARK(BM_InsertPassive)->ArgsProduct({ {0, 1}, {10000} });
+
+
+static void BM_Pull( benchmark::State& state )
+{
+    const size_t levels = 50;
+    const size_t per    = size_t( state.range(1) ) / ( 2 * levels );
+
+    for( auto _ : state )
+    {
+        state.PauseTiming();
+        UniqueIDGenerator id_gen;
+        auto book = MakeBook( state, id_gen );
+        FillBook( *book, levels, per );
+        state.ResumeTiming();
+
+        // pull in insertion order, i.e. from the front of each queue
+        for( size_t id = 1; id <= 2 * levels * per; ++id )
+        {
+            book->Pull( id );
+        }
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed( state.iterations() * int64_t( 2 * levels * per ) );
+}
+BENCHMARK(BM_Pull)->ArgsProduct({ {0, 1}, {10000} });
+
+
+static void BM_CancelSide( benchmark::State& state )
+{
+    const size_t levels = 50;
+    const size_t per    = size_t( state.range(1) ) / ( 2 * levels );
+
+    for( auto _ : state )
+    {
+        state.PauseTiming();
+        UniqueIDGenerator id_gen;
+        auto book = MakeBook( state, id_gen );
+        FillBook( *book, levels, per );
+        state.ResumeTiming();
+
+        // same orders as 'BM_Pull', removed level by level
+        book->CancelSide( OrderBook::Side::BUY );
+        book->CancelSide( OrderBook::Side::SELL );
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed( state.iterations() * int64_t( 2 * levels * per ) );
+}
+BENCHMARK(BM_CancelSide)->ArgsProduct({ {0, 1}, {10000} });
+
+
+static void BM_AggressiveRemainder( benchmark::State& state )
+{
+    // range(1): 0 = insert the aggressive order and pull what is left of it, 1 = 'IOC'
+    const bool ioc = 0 != state.range(1);
+
+    UniqueIDGenerator id_gen;
+    auto book = MakeBook( state, id_gen );
+    book->SetTradeSink( []( const OrderBook::ExecutedTrade& ) {} );
+    FillBook( *book, 50, 10 );
+
+    size_t id = 1000000;
+    for( auto _ : state )
+    {
+        // refill the best ask, then buy twice its volume at the same price
+        book->Insert( id++, OrderBook::Side::SELL, PassivePrice( OrderBook::Side::SELL, 0 ), 10 );
+
+        if( ioc )
+        {
+            book->Insert( id++, OrderBook::Side::BUY, PassivePrice( OrderBook::Side::SELL, 0 ), 20, OrderBook::kNoOwner, OrderBook::TimeInForce::IOC );
+        }
+        else
+        {
+            book->Insert( id, OrderBook::Side::BUY, PassivePrice( OrderBook::Side::SELL, 0 ), 20 );
+            book->Pull( id++ );
+        }
+    }
+
+    state.SetItemsProcessed( state.iterations() );
+}
+BENCHMARK(BM_AggressiveRemainder)->ArgsProduct({ {0, 1}, {0, 1} });
+
+
+static void BM_AmendVolumeDecrease( benchmark::State& state )
+{
+    const size_t levels = 50;
+    const size_t per    = size_t( state.range(1) ) / ( 2 * levels );
+
+    UniqueIDGenerator id_gen;
+    auto book = MakeBook( state, id_gen );
+    size_t vol = size_t(1) << 40;
+    FillBook( *book, levels, per, vol );
+
+    // every order keeps its time priority as the volume only goes down
+    for( auto _ : state )
+    {
+        --vol;
+        for( size_t id = 1; id <= 2 * levels * per; ++id )
+        {
+            book->Amend( id, PassivePrice( id % 2 ? OrderBook::Side::BUY : OrderBook::Side::SELL, ( id - 1 ) / ( 2 * per ) ), vol );
+        }
+    }
+
+    state.SetItemsProcessed( state.iterations() * int64_t( 2 * levels * per ) );
+}
+BENCHMARK(BM_AmendVolumeDecrease)->ArgsProduct({ {0, 1}, {10000} });
+
+
+static void BM_GetPriceLevels( benchmark::State& state )
+{
+    UniqueIDGenerator id_gen;
+    auto book = MakeBook( state, id_gen );
+    FillBook( *book, size_t( state.range(1) ), 10 );
+
+    std::vector<uint64_t> latency;
+    latency.reserve( size_t( state.max_iterations ) );
+    for( auto _ : state )
+    {
+        const auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize( book->GetPriceLevels() );
+        const auto end   = std::chrono::steady_clock::now();
+
+        latency.push_back( uint64_t( std::chrono::nanoseconds( end - start ).count() ) );
+    }
+
+    ReportLatency( state, "GetPriceLevels", latency );
+}
+BENCHMARK(BM_GetPriceLevels)->ArgsProduct({ {0, 1}, {10, 100} });
+
+
+static void BM_GetDepth( benchmark::State& state )
+{
+    UniqueIDGenerator id_gen;
+    auto book = MakeBook( state, id_gen );
+    FillBook( *book, 100, 10 );
+
+    std::vector<OrderBook::PriceLevel> depth( size_t( state.range(1) ) );
+    for( auto _ : state )
+    {
+        benchmark::DoNotOptimize( book->GetDepth( depth.size(), depth ) );
+    }
+}
+BENCHMARK(BM_GetDepth)->ArgsProduct({ {0, 1}, {1, 10} });
+
+
+/*
+ * Looks up every order of a single price level of 'range(1)' orders in turn, walking the orders
+ * ahead ('OrderBook') or asking the queue position index ('QueuePositionOrderBook').
+ */
+template< class Book >
+static void BM_QueuePosition( benchmark::State& state )
+{
+    const size_t orders = size_t( state.range(1) );
+
+    UniqueIDGenerator id_gen;
+    auto book = MakeBook<Book>( state, id_gen );
+    for( size_t id = 1; id <= orders; ++id ) { book->Insert( id, Book::Side::BUY, kMid, 10 ); }
+
+    typename Book::QueuePosition position;
+    size_t id = 0;
+    for( auto _ : state )
+    {
+        id = id % orders + 1;
+        benchmark::DoNotOptimize( book->GetQueuePosition( id, position ) );
+    }
+}
+BENCHMARK_TEMPLATE(BM_QueuePosition, OrderBook)->ArgsProduct({ {0, 1}, {100, 10000} });
+BENCHMARK_TEMPLATE(BM_QueuePosition, QueuePositionOrderBook)->ArgsProduct({ {0, 1}, {100, 10000} });
+
+
+static void BM_DeepSweep( benchmark::State& state )
+{
+    const size_t levels = size_t( state.range(1) );
+    const size_t per    = 10;
+
+    std::vector<uint64_t> latency;
+    for( auto _ : state )
+    {
+        state.PauseTiming();
+        UniqueIDGenerator id_gen;
+        auto book = MakeBook( state, id_gen );
+        FillBook( *book, levels, per );
+        state.ResumeTiming();
+
+        // a single buy which takes out every sell level
+        const auto start = std::chrono::steady_clock::now();
+        book->Insert( 0, OrderBook::Side::BUY, PassivePrice( OrderBook::Side::SELL, levels ), levels * per * 10 );
+        const auto end   = std::chrono::steady_clock::now();
+
+        state.PauseTiming();
+        latency.push_back( uint64_t( std::chrono::nanoseconds( end - start ).count() ) );
+        book.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed( state.iterations() * int64_t( levels * per ) );
+    state.SetLabel( "items = fills" );
+    ReportLatency( state, "Sweep", latency );
+}
+BENCHMARK(BM_DeepSweep)->ArgsProduct({ {0, 1}, {10, 100} });
+
+
+/*
+ * Thin book in a wide price band: 'levels' sell levels 'gap' ticks apart, swept one level per
+ * insert, so finding the next best level has to skip 'gap' - 1 empty ticks every time.
+ */
+static void BM_GappedSweep( benchmark::State& state )
+{
+    const size_t levels = 100;
+    const size_t gap    = size_t( state.range(1) );
+
+    UniqueIDGenerator id_gen;
+    auto book = 0 == state.range(0)
+        ? std::make_unique<OrderBook>( "BENCH", id_gen )
+        : std::make_unique<OrderBook>( "BENCH", id_gen, kTick, kMid, kMid + kTick * double( levels * gap ) );
+
+    size_t id = 0;
+    for( auto _ : state )
+    {
+        state.PauseTiming();
+        for( size_t level = 0; level < levels; ++level )
+        {
+            book->Insert( id++, OrderBook::Side::SELL, kMid + kTick * double( level * gap ), 10 );
+        }
+        state.ResumeTiming();
+
+        for( size_t level = 0; level < levels; ++level )
+        {
+            book->Insert( id++, OrderBook::Side::BUY, kMid + kTick * double( level * gap ), 10 );
+        }
+    }
+
+    state.SetItemsProcessed( state.iterations() * int64_t( levels ) );
+}
+BENCHMARK(BM_GappedSweep)->ArgsProduct({ {0, 1}, {1, 100, 10000} });
+
+
+/*
+ * Synthetic order flow. Second argument is the aggressor ratio in percent.
+ * Reports messages/sec and per operation latency percentiles.
+ */
+static void BM_OrderFlow( benchmark::State& state )
+{
+    constexpr size_t kMessages = 200000;
+
+    OrderFlowConfig config;
+    config.aggressor_ratio = double( state.range(1) ) / 100.0;
+
+    OrderFlowGenerator generator( config );
+    const std::vector<OrderFlowMessage> messages = generator.Generate( kMessages );
+
+    std::vector<uint64_t> latency[3];
+    for( auto& samples : latency ) { samples.reserve( kMessages ); }
+
+    for( auto _ : state )
+    {
+        state.PauseTiming();
+        UniqueIDGenerator id_gen;
+        std::unique_ptr<OrderBook> book = 0 == state.range(0)
+            ? std::make_unique<OrderBook>( "BENCH", id_gen )
+            : std::make_unique<OrderBook>( "BENCH", id_gen, config.tick_size, generator.MinPrice(), generator.MaxPrice() );
+        for( auto& samples : latency ) { samples.clear(); }
+        state.ResumeTiming();
+
+        for( const OrderFlowMessage& message : messages )
+        {
+            const auto start = std::chrono::steady_clock::now();
+            book->Apply( message.command );
+            const auto end   = std::chrono::steady_clock::now();
+
+            latency[ size_t( message.command.type ) ].push_back( uint64_t( std::chrono::nanoseconds( end - start ).count() ) );
+        }
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed( state.iterations() * int64_t( kMessages ) );
+
+    ReportLatency( state, "Insert", latency[ size_t( OrderBook::Command::Type::INSERT ) ] );
+    ReportLatency( state, "Amend",  latency[ size_t( OrderBook::Command::Type::AMEND  ) ] );
+    ReportLatency( state, "Pull",   latency[ size_t( OrderBook::Command::Type::PULL   ) ] );
+}
+BENCHMARK(BM_OrderFlow)->ArgsProduct({ {0, 1}, {1, 10} })->Unit(benchmark::kMillisecond);
+
+
+/*
+ * Same order flow as 'BM_OrderFlow', handed to 'ApplyBatch()' one batch per arrival window, the
+ * way a gateway would hand over everything that arrived since the last batch. Second argument is
+ * the window in microseconds, at the default rate of 1000 messages per millisecond about as many
+ * messages arrive per window.
+ */
+static void BM_OrderFlowBatch( benchmark::State& state )
+{
+    constexpr size_t kMessages = 200000;
+    const uint64_t window_ns = uint64_t( state.range(1) ) * 1000;
+
+    OrderFlowConfig config;
+    OrderFlowGenerator generator( config );
+
+    std::vector<OrderBook::Command> commands;
+    std::vector<size_t>             batch_ends;  // one past the last command of every window with messages
+    uint64_t                        last_window = 0;
+    for( const OrderFlowMessage& message : generator.Generate( kMessages ) )
+    {
+        if( !commands.empty() && message.arrival_ns / window_ns != last_window )
+        {
+            batch_ends.push_back( commands.size() );
+        }
+        last_window = message.arrival_ns / window_ns;
+        commands.push_back( message.command );
+    }
+    batch_ends.push_back( commands.size() );
+
+    for( auto _ : state )
+    {
+        state.PauseTiming();
+        UniqueIDGenerator id_gen;
+        std::unique_ptr<OrderBook> book = 0 == state.range(0)
+            ? std::make_unique<OrderBook>( "BENCH", id_gen )
+            : std::make_unique<OrderBook>( "BENCH", id_gen, config.tick_size, generator.MinPrice(), generator.MaxPrice() );
+        state.ResumeTiming();
+
+        size_t begin = 0;
+        for( const size_t end : batch_ends )
+        {
+            book->ApplyBatch( std::span<const OrderBook::Command>( commands ).subspan( begin, end - begin ) );
+            begin = end;
+        }
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed( state.iterations() * int64_t( kMessages ) );
+    state.counters[ "batch_size" ] = double( kMessages ) / double( batch_ends.size() );
+}
+BENCHMARK(BM_OrderFlowBatch)->ArgsProduct({ {0, 1}, {1, 64} })->Unit(benchmark::kMillisecond);
+
+
+/*
+ * Same order flow as 'BM_OrderFlow' with the price levels, orders and trades growing as they come
+ * (second argument 0) or reserved up front in a 'HugePageResource' (second argument 1). Reports
+ * the page faults taken and the bytes the order book grew by while applying the messages.
+ */
+static void BM_WarmOrderFlow( benchmark::State& state )
+{
+    constexpr size_t kMessages = 200000;
+    const bool warm = 1 == state.range(1);
+
+    OrderFlowConfig config;
+    OrderFlowGenerator generator( config );
+    const std::vector<OrderFlowMessage> messages = generator.Generate( kMessages );
+    const size_t levels = size_t( ( generator.MaxPrice() - generator.MinPrice() ) / config.tick_size ) + 1;
+
+    HugePageResource memory( warm ? 256 * 1024 * 1024 : 1 );
+    std::pmr::memory_resource* upstream = warm ? &memory : std::pmr::get_default_resource();
+
+    int64_t faults = 0;
+    int64_t growth = 0;
+
+    for( auto _ : state )
+    {
+        state.PauseTiming();
+        UniqueIDGenerator id_gen;
+        std::unique_ptr<OrderBook> book = 0 == state.range(0)
+            ? std::make_unique<OrderBook>( "BENCH", id_gen, upstream )
+            : std::make_unique<OrderBook>( "BENCH", id_gen, config.tick_size, generator.MinPrice(), generator.MaxPrice(), upstream );
+        if( warm ) { book->Reserve( kMessages, levels, kMessages ); }
+
+        const size_t before = book->GetMemoryUsage().Total();
+        rusage usage {};
+        ::getrusage( RUSAGE_SELF, &usage );
+        const long minflt = usage.ru_minflt;
+        state.ResumeTiming();
+
+        for( const OrderFlowMessage& message : messages )
+        {
+            book->Apply( message.command );
+        }
+
+        state.PauseTiming();
+        ::getrusage( RUSAGE_SELF, &usage );
+        faults += usage.ru_minflt - minflt;
+        growth += int64_t( book->GetMemoryUsage().Total() ) - int64_t( before );
+        book.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed( state.iterations() * int64_t( kMessages ) );
+    state.counters[ "page_faults"  ] = benchmark::Counter( double( faults ), benchmark::Counter::kAvgIterations );
+    state.counters[ "growth_bytes" ] = benchmark::Counter( double( growth ), benchmark::Counter::kAvgIterations );
+}
+BENCHMARK(BM_WarmOrderFlow)->ArgsProduct({ {0, 1}, {0, 1} })->Unit(benchmark::kMillisecond);
+
+
+BENCHMARK_MAIN();
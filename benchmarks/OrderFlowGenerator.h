@@ -0,0 +1,208 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "OrderBook.h"
+
+/**
+ * @brief Parameters of the synthetic order flow.
+ */
+struct OrderFlowConfig
+{
+    // message mix, normalized by the generator
+    double insert_ratio   = 0.4;
+    double amend_ratio    = 0.3;
+    double pull_ratio     = 0.3;
+
+    double aggressor_ratio     = 0.05;    // Share of inserts priced through the opposite side.
+    size_t sweep_levels        = 5;       // Aggressive orders are priced up to this many ticks through the mid.
+
+    double arrival_rate_per_ms = 1000.0;  // Mean message rate of the Poisson arrival process.
+    double mid_volatility      = 0.5;     // Standard deviation of the mid price per millisecond, in ticks.
+
+    double mid_price           = 100.0;   // Starting mid price.
+    double tick_size           = 0.01;
+    size_t book_depth          = 50;      // Passive orders rest at most this many ticks away from the mid.
+    double level_decay         = 0.15;    // Passive order distance from the mid is geometric with this parameter.
+
+    size_t max_vol             = 100;     // Order volumes are uniform in [1, max_vol].
+    uint64_t seed              = 42;
+};
+
+
+/**
+ * @brief A generated command and the time it arrived at, relative to the first message.
+ */
+struct OrderFlowMessage
+{
+    OrderBook::Command command;
+    uint64_t           arrival_ns;
+};
+
+
+/**
+ * @brief Generates a reproducible stream of Insert/Amend/Pull commands around a mid price that
+ *        follows a random walk. Message arrivals are a Poisson process and the mid moves with time,
+ *        so bursts of messages see a similar book. Amends and pulls target previously inserted
+ *        orders, which may have been matched in the meantime.
+ */
+class OrderFlowGenerator
+{
+public:
+
+    explicit OrderFlowGenerator( const OrderFlowConfig& config )
+    : mConfig       { config },
+      mRng          { config.seed },
+      mArrival      { config.arrival_rate_per_ms / 1e6 },
+      mDistance     { config.level_decay },
+      mVol          { 1, config.max_vol },
+      mMidTicks     { config.mid_price / config.tick_size },
+      mMinMidTicks  { mMidTicks - double(MaxMidDrift()) },
+      mMaxMidTicks  { mMidTicks + double(MaxMidDrift()) }
+    {
+        const double total = config.insert_ratio + config.amend_ratio + config.pull_ratio;
+        mInsertBelow = config.insert_ratio / total;
+        mAmendBelow  = ( config.insert_ratio + config.amend_ratio ) / total;
+    }
+
+
+    /**
+     * @brief Lowest and highest price the generator will ever produce, e.g. for the price band of an order book.
+     */
+    double MinPrice() const { return ( mMinMidTicks - double( mConfig.book_depth + mConfig.sweep_levels + 1 ) ) * mConfig.tick_size; }
+    double MaxPrice() const { return ( mMaxMidTicks + double( mConfig.book_depth + mConfig.sweep_levels + 1 ) ) * mConfig.tick_size; }
+
+
+    /**
+     * @brief Generates the next message.
+     */
+    OrderFlowMessage Next()
+    {
+        AdvanceClock();
+
+        OrderBook::Command command {};
+        const double kind = mUniform( mRng );
+
+        if( kind < mInsertBelow || mLiveIds.empty() )
+        {
+            command.type  = OrderBook::Command::Type::INSERT;
+            command.side  = mUniform( mRng ) < 0.5 ? OrderBook::Side::BUY : OrderBook::Side::SELL;
+            command.id    = mNextId++;
+            command.price = Price( command.side, mUniform( mRng ) < mConfig.aggressor_ratio );
+            command.vol   = mVol( mRng );
+
+            mLiveIds.push_back( command.id );
+            mSides.push_back( command.side );
+        }
+        else
+        {
+            const size_t index = std::uniform_int_distribution<size_t>( 0, mLiveIds.size() - 1 )( mRng );
+            command.id   = mLiveIds[index];
+            command.side = mSides[index];
+
+            if( kind < mAmendBelow )
+            {
+                command.type  = OrderBook::Command::Type::AMEND;
+                command.price = Price( command.side, false );
+                command.vol   = mVol( mRng );
+            }
+            else
+            {
+                command.type = OrderBook::Command::Type::PULL;
+
+                // swap remove, order of live ids does not matter
+                mLiveIds[index] = mLiveIds.back();
+                mSides[index]   = mSides.back();
+                mLiveIds.pop_back();
+                mSides.pop_back();
+            }
+        }
+
+        return OrderFlowMessage{ command, mNowNs };
+    }
+
+
+    /**
+     * @brief Generates 'count' messages.
+     */
+    std::vector<OrderFlowMessage> Generate( const size_t count )
+    {
+        std::vector<OrderFlowMessage> messages;
+        messages.reserve( count );
+
+        for( size_t i = 0; i < count; ++i )
+        {
+            messages.push_back( Next() );
+        }
+
+        return messages;
+    }
+
+
+private:
+
+    /**
+     * @brief The mid never wanders further than this many ticks from where it started.
+     */
+    size_t MaxMidDrift() const
+    {
+        return 10 * mConfig.book_depth;
+    }
+
+
+    /**
+     * @brief Moves time forward by an exponentially distributed gap and lets the mid follow.
+     */
+    void AdvanceClock()
+    {
+        const double gap_ns = mArrival( mRng );
+        mNowNs += uint64_t( gap_ns );
+
+        const double gap_ms = gap_ns / 1e6;
+        mMidTicks += std::normal_distribution<double>( 0.0, mConfig.mid_volatility * std::sqrt( gap_ms ) )( mRng );
+        mMidTicks  = std::clamp( mMidTicks, mMinMidTicks, mMaxMidTicks );
+    }
+
+
+    /**
+     * @brief Price of a passive order near the mid, or of an aggressive one priced through it.
+     */
+    double Price( const OrderBook::Side side, const bool aggressive )
+    {
+        const double direction = OrderBook::Side::BUY == side ? -1.0 : 1.0;
+        const double mid       = std::round( mMidTicks );
+        double       distance;
+
+        if( aggressive )
+        {
+            distance = -double( std::uniform_int_distribution<size_t>( 1, mConfig.sweep_levels )( mRng ) );
+        }
+        else
+        {
+            distance = double( 1 + std::min( mDistance( mRng ), mConfig.book_depth - 1 ) );
+        }
+
+        return ( mid + direction * distance ) * mConfig.tick_size;
+    }
+
+
+    const OrderFlowConfig mConfig;
+    std::mt19937_64 mRng;
+    std::exponential_distribution<double>  mArrival;       // Gap between messages in ns.
+    std::geometric_distribution<size_t>    mDistance;      // Ticks between the mid and a passive order.
+    std::uniform_int_distribution<size_t>  mVol;
+    std::uniform_real_distribution<double> mUniform { 0.0, 1.0 };
+
+    double   mInsertBelow { 0 };        // Message is an insert if a uniform draw is below this.
+    double   mAmendBelow  { 0 };        // Otherwise an amend if below this, else a pull.
+    double   mMidTicks;                 // Current mid price in ticks.
+    const double mMinMidTicks;
+    const double mMaxMidTicks;
+    uint64_t mNowNs  { 0 };             // Arrival time of the last message.
+    size_t   mNextId { 1 };             // Order id of the next insert.
+    std::vector<size_t>          mLiveIds;  // Ids which have been inserted and not pulled.
+    std::vector<OrderBook::Side> mSides;    // Side of each entry in 'mLiveIds'.
+};
@@ -0,0 +1,128 @@
+#include "CommandJournal.h"
+
+#include <cstring>
+
+
+CommandJournal::CommandJournal( const std::string& path, const FsyncPolicy policy, const size_t batch_size )
+: mPath      { path },
+  mPolicy    { policy },
+  mBatchSize { FsyncPolicy::EVERY_RECORD == policy || batch_size < 1 ? 1 : batch_size }
+{
+    mFd = ::open( path.c_str(), O_RDWR | O_CREAT, 0644 );
+    if( mFd < 0 ) { ThrowSystemError( "CommandJournal: cannot open " + path ); }
+
+    struct stat info;
+    if( ::fstat( mFd, &info ) < 0 ) { ::close( mFd ); ThrowSystemError( "CommandJournal: cannot stat " + path ); }
+
+    size_t size = size_t(info.st_size);
+
+    if( 0 == size )
+    {
+        Header header {};
+        std::memcpy( header.magic, kMagic, sizeof(kMagic) );
+        header.version     = kVersion;
+        header.record_size = sizeof(Record);
+
+        WriteAll( mFd, &header, sizeof(header) );
+        size = sizeof(header);
+    }
+    else
+    {
+        Header header {};
+        if( size < sizeof(header) || ::pread( mFd, &header, sizeof(header), 0 ) != ssize_t(sizeof(header)) ||
+            0 != std::memcmp( header.magic, kMagic, sizeof(kMagic) ) || header.version < kMinVersion || header.version > kVersion ||
+            sizeof(Record) != header.record_size )
+        {
+            ::close( mFd );
+            throw std::system_error( std::make_error_code( std::errc::invalid_argument ), "CommandJournal: not a journal file " + path );
+        }
+
+        // records of older versions read the same as current ones, so the journal is upgraded before anything newer is appended
+        if( kVersion != header.version )
+        {
+            header.version = kVersion;
+            if( ::pwrite( mFd, &header, sizeof(header), 0 ) != ssize_t(sizeof(header)) )
+            {
+                ::close( mFd );
+                ThrowSystemError( "CommandJournal: cannot upgrade " + path );
+            }
+        }
+
+        // drop a record which was only partially written before a crash
+        const size_t complete = size - ( size - sizeof(header) ) % sizeof(Record);
+        if( complete != size && ::ftruncate( mFd, off_t(complete) ) < 0 )
+        {
+            ::close( mFd );
+            ThrowSystemError( "CommandJournal: cannot truncate " + path );
+        }
+        size = complete;
+    }
+
+    if( ::lseek( mFd, off_t(size), SEEK_SET ) < 0 ) { ::close( mFd ); ThrowSystemError( "CommandJournal: cannot seek " + path ); }
+
+    mBuffer.reserve( mBatchSize );
+}
+
+
+CommandJournal::~CommandJournal()
+{
+    try
+    {
+        Flush();
+    }
+    catch( const std::system_error& )
+    {
+        // nothing sensible left to do in a destructor
+    }
+
+    ::close( mFd );
+}
+
+
+void CommandJournal::AppendRecord( const Record& record )
+{
+    mBuffer.push_back( record );
+
+    if( mBuffer.size() >= mBatchSize )
+    {
+        Flush();
+    }
+}
+
+
+void CommandJournal::Flush()
+{
+    if( mBuffer.empty() ) { return; }
+
+    WriteBuffer();
+
+    if( FsyncPolicy::NEVER != mPolicy && ::fdatasync( mFd ) < 0 )
+    {
+        ThrowSystemError( "CommandJournal: cannot sync " + mPath );
+    }
+}
+
+
+void CommandJournal::WriteBuffer()
+{
+    WriteAll( mFd, mBuffer.data(), mBuffer.size() * sizeof(Record) );
+    mBuffer.clear();
+}
+
+
+size_t CommandJournal::CheckHeader( const MappedFile& file, const std::string& path )
+{
+    if( file.Size() < sizeof(Header) )
+    {
+        return 0;
+    }
+
+    const Header& header = *reinterpret_cast<const Header*>( file.Data() );
+    if( 0 != std::memcmp( header.magic, kMagic, sizeof(kMagic) ) || header.version < kMinVersion || header.version > kVersion ||
+        sizeof(Record) != header.record_size )
+    {
+        throw std::system_error( std::make_error_code( std::errc::invalid_argument ), "CommandJournal: not a journal file " + path );
+    }
+
+    return ( file.Size() - sizeof(Header) ) / sizeof(Record);
+}
@@ -0,0 +1,178 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "OrderBook.h"
+#include "PosixFile.h"
+
+/**
+ * @brief Append only binary journal of the commands accepted by an order book. Every command
+ *        is stored as a fixed size record, so a journal can be replayed by memory mapping the
+ *        file and walking the records in place.
+ *
+ * Records are buffered and written in batches. How often the file is synced to disk is set
+ * by the 'FsyncPolicy'. Throws 'std::system_error' on I/O errors.
+ */
+class CommandJournal
+{
+public:
+
+    enum class FsyncPolicy
+    {
+        NEVER = 0,     // Leave syncing to the operating system.
+        EVERY_BATCH,   // Sync each time a batch of records is written.
+        EVERY_RECORD   // Write and sync every record before returning from 'Append()'.
+    };
+
+
+    /**
+     * @brief On disk format of a single command.
+     */
+    struct Record
+    {
+        uint8_t  type;         // 'OrderBook::Command::Type'
+        uint8_t  side;         // 'OrderBook::Side'
+        uint8_t  tif;          // 'OrderBook::TimeInForce', 0 ('GTC') in journals written before it existed.
+        uint8_t  reserved;     // Always 0.
+        uint32_t owner;        // 'OrderBook::OwnerTag', 0 in journals written before owners existed.
+        uint64_t id;
+        double   price;
+        uint64_t vol;
+    };
+
+    static_assert( sizeof(Record) == 32, "journal records must have a fixed size" );
+
+
+    /**
+     * @brief Opens 'path' for appending, creating it if it does not exist.
+     *
+     * @param path        Journal file.
+     * @param policy      When to sync the file to disk.
+     * @param batch_size  Number of records buffered before they are written to the file.
+     */
+    CommandJournal( const std::string& path, const FsyncPolicy policy = FsyncPolicy::EVERY_BATCH, const size_t batch_size = 1024 );
+
+
+    /**
+     * @brief Writes buffered records and closes the file.
+     */
+    ~CommandJournal();
+
+    CommandJournal( const CommandJournal& ) = delete;
+    CommandJournal& operator=( const CommandJournal& ) = delete;
+
+
+    /**
+     * @brief Adds 'command', an 'OrderBook::Command' or the command of any other 'BasicOrderBook', to the journal.
+     */
+    template< class Command >
+    void Append( const Command& command )
+    {
+        Record record {};
+        record.type  = uint8_t( command.type );
+        record.side  = uint8_t( command.side );
+        record.id    = uint64_t( command.id );
+        record.price = double( command.price );
+        record.vol   = uint64_t( command.vol );
+        record.owner = uint32_t( command.owner );
+        record.tif   = uint8_t( command.tif );
+
+        AppendRecord( record );
+    }
+
+    void Append( const OrderBook::Command& command )
+    {
+        Append< OrderBook::Command >( command );
+    }
+
+
+    /**
+     * @brief Adds 'record' to the journal.
+     */
+    void AppendRecord( const Record& record );
+
+
+    /**
+     * @brief Writes all buffered records to the file and syncs it unless the policy is 'NEVER'.
+     */
+    void Flush();
+
+
+    /**
+     * @brief Memory maps the journal at 'path' and applies all complete records to 'book'.
+     *        A partially written record at the end of the file is ignored.
+     *
+     * @return Number of records applied.
+     */
+    template< class Book >
+    static size_t Replay( const std::string& path, Book& book )
+    {
+        using Command = typename Book::Command;
+
+        const MappedFile file( path );
+        const size_t     count   = CheckHeader( file, path );
+        const Record*    records = reinterpret_cast<const Record*>( file.Data() + sizeof(Header) );
+
+        // don't journal the commands a second time while replaying them
+        CommandJournal* journal = book.GetJournal();
+        book.SetJournal( nullptr );
+
+        try
+        {
+            for( size_t i = 0; i < count; ++i )
+            {
+                const Record& r = records[i];
+                book.Apply( Command{ typename Command::Type(r.type), typename Book::Side(r.side), decltype(Command::id)(r.id),
+                                     decltype(Command::price)(r.price), decltype(Command::vol)(r.vol), decltype(Command::owner)(r.owner),
+                                     decltype(Command::tif)(r.tif) } );
+            }
+        }
+        catch( ... )
+        {
+            book.SetJournal( journal );
+            throw;
+        }
+
+        book.SetJournal( journal );
+
+        return count;
+    }
+
+
+private:
+
+    /**
+     * @brief Writes the buffered records to the file without syncing.
+     */
+    void WriteBuffer();
+
+
+    /**
+     * @brief Checks the header of the mapped journal 'file'. Throws 'std::system_error' if it is
+     *        not a journal. Returns the number of complete records, 0 if there is no header.
+     */
+    static size_t CheckHeader( const MappedFile& file, const std::string& path );
+
+
+    /**
+     * @brief Start of the journal file.
+     */
+    struct Header
+    {
+        char     magic[8];     // 'kMagic'
+        uint32_t version;      // 'kMinVersion' to 'kVersion'
+        uint32_t record_size;  // 'sizeof(Record)'
+    };
+
+    static constexpr char     kMagic[8]   { 'O', 'B', 'J', 'O', 'U', 'R', 'N', 'L' };
+    static constexpr uint32_t kVersion    { 2 };  // Owners, time in force and the commands using them.
+    static constexpr uint32_t kMinVersion { 1 };  // Oldest version read, its 'reserved' bytes are all 0.
+
+    const std::string   mPath;        // Path of the journal file.
+    const FsyncPolicy   mPolicy;      // When to sync the file.
+    const size_t        mBatchSize;   // Number of records written at a time.
+    int                 mFd { -1 };   // File descriptor of the journal file.
+    std::vector<Record> mBuffer;      // Records not yet written to the file.
+};
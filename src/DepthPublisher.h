@@ -0,0 +1,136 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+/**
+ * @brief Lock free publication of the top price levels of an order book to any number of reader
+ *        threads, protected by a sequence lock. The single writer (the thread running the order
+ *        book) never waits for readers. A reader copies the levels and retries if the writer
+ *        published in the meantime, so every copy it returns is a consistent snapshot.
+ *
+ * The levels are stored as relaxed atomic words, so reading while the writer publishes is not a
+ * data race. 'Level' must be trivially copyable, e.g. 'OrderBook::PriceLevel'.
+ */
+template< class Level >
+class DepthPublisher
+{
+    static_assert( std::is_trivially_copyable_v<Level>, "levels are copied word by word" );
+
+public:
+
+    /**
+     * @param max_levels  Maximum number of price levels published.
+     */
+    explicit DepthPublisher( const size_t max_levels )
+    : mMaxLevels { max_levels },
+      mWords     { std::make_unique< std::atomic<uint64_t>[] >( max_levels * kWordsPerLevel ) }
+    {
+    }
+
+    DepthPublisher( const DepthPublisher& ) = delete;
+    DepthPublisher& operator=( const DepthPublisher& ) = delete;
+
+
+    size_t MaxLevels() const { return mMaxLevels; }
+
+
+    /**
+     * @brief Replaces the published levels by the first 'MaxLevels()' of 'levels'. Writer thread only.
+     */
+    void Publish( std::span<const Level> levels )
+    {
+        const size_t   count = std::min( levels.size(), mMaxLevels );
+        const uint64_t seq   = mSeq.load( std::memory_order_relaxed );
+
+        // an odd sequence number tells readers that the levels are being written
+        mSeq.store( seq + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+
+        mCount.store( count, std::memory_order_relaxed );
+        for( size_t i = 0; i < count; ++i )
+        {
+            uint64_t words[kWordsPerLevel] {};
+            std::memcpy( words, &levels[i], sizeof(Level) );
+
+            for( size_t w = 0; w < kWordsPerLevel; ++w )
+            {
+                mWords[ i * kWordsPerLevel + w ].store( words[w], std::memory_order_relaxed );
+            }
+        }
+
+        mSeq.store( seq + 2, std::memory_order_release );
+    }
+
+
+    /**
+     * @brief Copies the published levels into 'out' once, without retrying. Any thread.
+     *
+     * @param out      Receives up to 'out.size()' levels, best prices first.
+     * @param count    Number of levels written to 'out'.
+     * @param version  Number of 'Publish()' calls the copy reflects.
+     * @return         False if the writer published during the copy, in which case 'out' is garbage.
+     */
+    bool TryRead( std::span<Level> out, size_t& count, uint64_t& version ) const
+    {
+        const uint64_t before = mSeq.load( std::memory_order_acquire );
+        if( before & 1 ) { return false; }
+
+        count = std::min<size_t>( { size_t( mCount.load( std::memory_order_relaxed ) ), out.size(), mMaxLevels } );
+        for( size_t i = 0; i < count; ++i )
+        {
+            uint64_t words[kWordsPerLevel];
+            for( size_t w = 0; w < kWordsPerLevel; ++w )
+            {
+                words[w] = mWords[ i * kWordsPerLevel + w ].load( std::memory_order_relaxed );
+            }
+
+            std::memcpy( &out[i], words, sizeof(Level) );
+        }
+
+        std::atomic_thread_fence( std::memory_order_acquire );
+        version = before / 2;
+        return before == mSeq.load( std::memory_order_relaxed );
+    }
+
+
+    /**
+     * @brief Same as 'TryRead()', but retries until the copy is consistent. Any thread.
+     *
+     * @return Number of levels written to 'out'.
+     */
+    size_t Read( std::span<Level> out, uint64_t* version = nullptr ) const
+    {
+        size_t   count = 0;
+        uint64_t seen  = 0;
+        while( !TryRead( out, count, seen ) ) {}
+
+        if( version ) { *version = seen; }
+        return count;
+    }
+
+
+    /**
+     * @brief Returns the number of completed 'Publish()' calls. Any thread.
+     */
+    uint64_t Version() const
+    {
+        return mSeq.load( std::memory_order_acquire ) / 2;
+    }
+
+
+private:
+
+    static constexpr size_t kCacheLineSize = 64;
+    static constexpr size_t kWordsPerLevel = ( sizeof(Level) + sizeof(uint64_t) - 1 ) / sizeof(uint64_t);
+
+    alignas(kCacheLineSize) std::atomic<uint64_t> mSeq { 0 };  // Twice the number of publications, odd while publishing.
+    std::atomic<uint64_t> mCount { 0 };                        // Number of published levels.
+    const size_t mMaxLevels;                                   // Capacity of 'mWords' in levels.
+    std::unique_ptr< std::atomic<uint64_t>[] > mWords;         // The levels, 'kWordsPerLevel' words each.
+};
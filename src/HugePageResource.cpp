@@ -0,0 +1,119 @@
+#include "HugePageResource.h"
+#include "PosixFile.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+
+namespace
+{
+    constexpr size_t kPageSize = 4096;  // Smallest page size, prefaulting touches every page of this size.
+
+
+    /**
+     * @brief Maps 'bytes' of explicit huge pages, all faulted in. Returns nullptr if there are not
+     *        enough huge pages reserved.
+     */
+    std::byte* MapHugeTlbPages( const size_t bytes )
+    {
+#ifdef MAP_HUGETLB
+        void* region = ::mmap( nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0 );
+        if( MAP_FAILED != region ) { return static_cast<std::byte*>( region ); }
+#else
+        (void)bytes;
+#endif
+        return nullptr;
+    }
+
+
+    /**
+     * @brief Maps 'bytes' of normal pages aligned to a huge page, so the kernel can back them with
+     *        transparent huge pages, and faults them in.
+     */
+    std::byte* MapTransparentPages( const size_t bytes )
+    {
+        const size_t mapped = bytes + HugePageResource::kHugePageSize;
+        void*        region = ::mmap( nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        if( MAP_FAILED == region ) { ThrowSystemError( "HugePageResource: cannot map memory" ); }
+
+        // give back what lies before the first and after the last huge page boundary used
+        const uintptr_t start   = reinterpret_cast<uintptr_t>( region );
+        const uintptr_t aligned = ( start + HugePageResource::kHugePageSize - 1 ) & ~uintptr_t( HugePageResource::kHugePageSize - 1 );
+        if( aligned > start )                  { ::munmap( region, aligned - start ); }
+        if( start + mapped > aligned + bytes ) { ::munmap( reinterpret_cast<void*>( aligned + bytes ), start + mapped - aligned - bytes ); }
+
+        auto* data = reinterpret_cast<std::byte*>( aligned );
+
+#ifdef MADV_HUGEPAGE
+        ::madvise( data, bytes, MADV_HUGEPAGE );  // only a hint, the kernel may not have transparent huge pages enabled
+#endif
+
+        for( size_t offset = 0; offset < bytes; offset += kPageSize )
+        {
+            *static_cast<volatile std::byte*>( data + offset ) = std::byte{ 0 };
+        }
+
+        return data;
+    }
+}
+
+
+HugePageResource::HugePageResource( const size_t bytes, std::pmr::memory_resource* fallback )
+: mFallback { fallback },
+  mCapacity { ( std::max<size_t>( bytes, 1 ) + kHugePageSize - 1 ) / kHugePageSize * kHugePageSize }
+{
+    mRegion  = MapHugeTlbPages( mCapacity );
+    mBacking = Backing::HUGETLB;
+
+    if( nullptr == mRegion )
+    {
+        mRegion  = MapTransparentPages( mCapacity );
+        mBacking = Backing::TRANSPARENT;
+    }
+}
+
+
+HugePageResource::~HugePageResource()
+{
+    ::munmap( mRegion, mCapacity );
+}
+
+
+void* HugePageResource::do_allocate( const size_t bytes, const size_t alignment )
+{
+    const size_t offset = ( mUsed + alignment - 1 ) & ~( alignment - 1 );
+
+    if( offset < mCapacity && bytes <= mCapacity - offset )
+    {
+        mUsed = offset + bytes;
+        ++mBlocks;
+        return mRegion + offset;
+    }
+
+    void* block = mFallback->allocate( bytes, alignment );
+    mFallbackBytes += bytes;
+    return block;
+}
+
+
+void HugePageResource::do_deallocate( void* p, const size_t bytes, const size_t alignment )
+{
+    auto* block = static_cast<std::byte*>( p );
+
+    if( !std::less<>()( block, mRegion ) && std::less<>()( block, mRegion + mCapacity ) )
+    {
+        // the region is reused from the start once nothing in it is in use anymore
+        if( 0 == --mBlocks ) { mUsed = 0; }
+        return;
+    }
+
+    mFallback->deallocate( p, bytes, alignment );
+    mFallbackBytes -= bytes;
+}
+
+
+bool HugePageResource::do_is_equal( const std::pmr::memory_resource& other ) const noexcept
+{
+    return this == &other;
+}
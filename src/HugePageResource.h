@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @brief Memory resource handing out memory from a single region which is mapped and prefaulted
+ *        up front, from 2 MB huge pages if possible. Passed as the 'upstream' resource of an
+ *        order book and followed by 'Reserve()', the order book neither page faults nor takes
+ *        memory from the system allocator once warmed up.
+ *
+ * The region is mapped from explicit huge pages (MAP_HUGETLB) if the system has enough of them
+ * reserved, otherwise from normal pages with transparent huge pages requested. Allocations which
+ * do not fit into the region anymore go to the 'fallback' resource.
+ *
+ * Blocks are carved off the region one after another. Freed blocks are only reused once all
+ * blocks of the region have been freed, as happens when the order book is reset or destroyed.
+ * Not thread safe, like the order book using it.
+ */
+class HugePageResource : public std::pmr::memory_resource
+{
+public:
+
+    static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+
+    /**
+     * @brief How the region is backed.
+     */
+    enum class Backing
+    {
+        HUGETLB,      // Explicit huge pages.
+        TRANSPARENT,  // Normal pages, which the kernel may merge into transparent huge pages.
+    };
+
+
+    /**
+     * @param bytes     Size of the region, rounded up to a whole number of huge pages.
+     * @param fallback  Serves the allocations which do not fit into the region.
+     */
+    explicit HugePageResource( const size_t bytes, std::pmr::memory_resource* fallback = std::pmr::get_default_resource() );
+
+    ~HugePageResource() override;
+
+    HugePageResource( const HugePageResource& ) = delete;
+    HugePageResource& operator=( const HugePageResource& ) = delete;
+
+
+    Backing GetBacking() const { return mBacking; }
+
+
+    /**
+     * @brief Returns the size of the region in bytes.
+     */
+    size_t Capacity() const { return mCapacity; }
+
+
+    /**
+     * @brief Returns the number of bytes of the region carved off so far, including freed blocks
+     *        which have not been reused yet.
+     */
+    size_t Used() const { return mUsed; }
+
+
+    /**
+     * @brief Returns the number of bytes currently allocated from the fallback resource.
+     */
+    size_t FallbackBytes() const { return mFallbackBytes; }
+
+
+private:
+
+    void* do_allocate( const size_t bytes, const size_t alignment ) override;
+    void  do_deallocate( void* p, const size_t bytes, const size_t alignment ) override;
+    bool  do_is_equal( const std::pmr::memory_resource& other ) const noexcept override;
+
+
+    std::pmr::memory_resource* const mFallback;
+    std::byte* mRegion { nullptr };                 // Start of the mapped region.
+    size_t     mCapacity { 0 };                     // Size of the region.
+    size_t     mUsed { 0 };                         // Offset of the first byte of the region not handed out yet.
+    size_t     mBlocks { 0 };                       // Number of blocks of the region not freed yet.
+    size_t     mFallbackBytes { 0 };                // Bytes taken from 'mFallback' and not freed yet.
+    Backing    mBacking { Backing::TRANSPARENT };
+};
@@ -0,0 +1,191 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+/**
+ * @brief Memory resource for the node based containers of one order book. Small blocks are
+ *        carved out of large chunks from the upstream resource and recycled through one free
+ *        list per size class, so allocating a node is a couple of instructions and the nodes of
+ *        one order book sit close together. Larger blocks go straight to the upstream resource.
+ *        'release()' gives all chunks back to the upstream resource at once.
+ *
+ * Not thread safe, like the order book using it.
+ */
+class NodeArena : public std::pmr::memory_resource
+{
+public:
+
+    static constexpr size_t kGranularity   = 16;     // Block sizes are rounded up to a multiple of this.
+    static constexpr size_t kMaxBlockSize  = 256;    // Larger blocks are not pooled.
+    static constexpr size_t kMinChunkSize  = 64 * 1024;
+
+
+    explicit NodeArena( std::pmr::memory_resource* upstream = std::pmr::get_default_resource() )
+    : mUpstream { upstream },
+      mChunks   { upstream }
+    {
+    }
+
+    ~NodeArena() override
+    {
+        release();
+    }
+
+    NodeArena( const NodeArena& ) = delete;
+    NodeArena& operator=( const NodeArena& ) = delete;
+
+
+    /**
+     * @brief Gives all chunks back to the upstream resource. Every pooled block becomes invalid.
+     */
+    void release()
+    {
+        for( const Chunk& chunk : mChunks )
+        {
+            mUpstream->deallocate( chunk.data, chunk.size, alignof(std::max_align_t) );
+        }
+
+        mChunks.clear();
+        mChunks.shrink_to_fit();
+        mFreeLists = {};
+        mNext      = nullptr;
+        mEnd       = nullptr;
+    }
+
+
+    /**
+     * @brief Takes enough memory from the upstream resource right away for the next 'blocks'
+     *        pooled blocks of 'block_size' bytes, so allocating them does not go upstream.
+     */
+    void Reserve( const size_t blocks, const size_t block_size )
+    {
+        if( 0 == blocks || 0 == block_size || block_size > kMaxBlockSize ) { return; }
+
+        const size_t bytes = blocks * ( SizeClass( block_size ) + 1 ) * kGranularity;
+        if( size_t( mEnd - mNext ) < bytes )
+        {
+            AddChunk( bytes );
+        }
+    }
+
+
+    /**
+     * @brief Returns the number of bytes held from the upstream resource for pooled blocks.
+     */
+    size_t GetChunkBytes() const
+    {
+        size_t bytes = 0;
+        for( const Chunk& chunk : mChunks ) { bytes += chunk.size; }
+        return bytes;
+    }
+
+
+    /**
+     * @brief Returns the number of bytes of the blocks which were too large to be pooled and
+     *        have not been deallocated yet.
+     */
+    size_t GetLargeBlockBytes() const
+    {
+        return mLargeBlockBytes;
+    }
+
+
+private:
+
+    /**
+     * @brief An unused block, linked into the free list of its size class.
+     */
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct Chunk
+    {
+        std::byte* data;
+        size_t     size;
+    };
+
+
+    void* do_allocate( const size_t bytes, const size_t alignment ) override
+    {
+        if( bytes > kMaxBlockSize || alignment > kGranularity )
+        {
+            void* block = mUpstream->allocate( bytes, alignment );
+            mLargeBlockBytes += bytes;
+            return block;
+        }
+
+        const size_t size_class = SizeClass( bytes );
+
+        if( FreeBlock* block = mFreeLists[size_class]; block )
+        {
+            mFreeLists[size_class] = block->next;
+            return block;
+        }
+
+        const size_t size = ( size_class + 1 ) * kGranularity;
+        if( size_t( mEnd - mNext ) < size )
+        {
+            AddChunk();
+        }
+
+        void* block = mNext;
+        mNext += size;
+        return block;
+    }
+
+
+    void do_deallocate( void* p, const size_t bytes, const size_t alignment ) override
+    {
+        if( bytes > kMaxBlockSize || alignment > kGranularity )
+        {
+            mUpstream->deallocate( p, bytes, alignment );
+            mLargeBlockBytes -= bytes;
+            return;
+        }
+
+        const size_t size_class = SizeClass( bytes );
+        mFreeLists[size_class] = new( p ) FreeBlock{ mFreeLists[size_class] };
+    }
+
+
+    bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override
+    {
+        return this == &other;
+    }
+
+
+    static size_t SizeClass( const size_t bytes )
+    {
+        return ( bytes + kGranularity - 1 ) / kGranularity - ( bytes > 0 ? 1 : 0 );
+    }
+
+
+    /**
+     * @brief Starts a new chunk, twice the size of the previous one or 'min_size' if that is
+     *        larger. What is left of the current chunk is not used anymore.
+     */
+    void AddChunk( const size_t min_size = 0 )
+    {
+        const size_t size = std::max( min_size, mChunks.empty() ? kMinChunkSize : 2 * mChunks.back().size );
+        auto*        data = static_cast<std::byte*>( mUpstream->allocate( size, alignof(std::max_align_t) ) );
+
+        mChunks.push_back( Chunk{ data, size } );
+        mNext = data;
+        mEnd  = data + size;
+    }
+
+
+    std::pmr::memory_resource* const mUpstream;
+    std::pmr::vector<Chunk> mChunks;                                      // All chunks taken from 'mUpstream'.
+    std::array< FreeBlock*, kMaxBlockSize / kGranularity > mFreeLists {};  // Unused blocks per size class.
+    std::byte* mNext { nullptr };                                         // Unused part of the last chunk.
+    std::byte* mEnd  { nullptr };
+    size_t mLargeBlockBytes { 0 };                                        // Outstanding blocks taken directly from 'mUpstream'.
+};
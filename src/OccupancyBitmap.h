@@ -0,0 +1,218 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+
+/**
+ * @brief Returns the index of the first non zero word in [begin, end), or 'end' if there is none.
+ *        Checks four words per instruction when compiled with AVX2.
+ */
+inline size_t FindNonZeroWord( const uint64_t* words, size_t begin, const size_t end )
+{
+#ifdef __AVX2__
+    for( ; begin + 4 <= end; begin += 4 )
+    {
+        const __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( words + begin ) );
+        if( !_mm256_testz_si256( v, v ) ) { break; }
+    }
+#endif
+
+    for( ; begin < end; ++begin )
+    {
+        if( 0 != words[begin] ) { return begin; }
+    }
+
+    return end;
+}
+
+
+/**
+ * @brief Returns the index of the last non zero word in [0, end), or 'SIZE_MAX' if there is none.
+ *        Checks four words per instruction when compiled with AVX2.
+ */
+inline size_t FindNonZeroWordReverse( const uint64_t* words, size_t end )
+{
+#ifdef __AVX2__
+    for( ; end >= 4; end -= 4 )
+    {
+        const __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( words + end - 4 ) );
+        if( !_mm256_testz_si256( v, v ) ) { break; }
+    }
+#endif
+
+    while( end > 0 )
+    {
+        if( 0 != words[--end] ) { return end; }
+    }
+
+    return SIZE_MAX;
+}
+
+
+/**
+ * @brief Two level bitmap of occupied slots. Every bit of 'mSummary' tells whether the
+ *        corresponding word of 'mWords' has any bit set, so the next occupied slot in either
+ *        direction is found with a couple of count leading/trailing zero instructions, plus a
+ *        scan over the summary (64 * 64 slots per summary word) only for very large gaps.
+ */
+class OccupancyBitmap
+{
+public:
+
+    static constexpr size_t kNone = SIZE_MAX;  // Returned if no slot is occupied.
+
+
+    /**
+     * @param slots     Number of slots.
+     * @param resource  Memory resource of the bitmap.
+     */
+    explicit OccupancyBitmap( const size_t slots = 0, std::pmr::memory_resource* resource = std::pmr::get_default_resource() )
+    : mWords   { resource },
+      mSummary { resource }
+    {
+        Resize( slots );
+    }
+
+
+    /**
+     * @brief Sets the number of slots and marks all of them as free.
+     */
+    void Resize( const size_t slots )
+    {
+        mWords.assign( ( slots + kBits - 1 ) / kBits, 0 );
+        mSummary.assign( ( mWords.size() + kBits - 1 ) / kBits, 0 );
+    }
+
+
+    /**
+     * @brief Removes all slots and gives the memory back to the memory resource.
+     */
+    void Release()
+    {
+        std::pmr::vector<uint64_t>( mWords.get_allocator() ).swap( mWords );
+        std::pmr::vector<uint64_t>( mSummary.get_allocator() ).swap( mSummary );
+    }
+
+
+    /**
+     * @brief Returns the number of bytes allocated for the bitmap.
+     */
+    size_t MemoryUsage() const
+    {
+        return ( mWords.capacity() + mSummary.capacity() ) * sizeof(uint64_t);
+    }
+
+
+    void Set( const size_t slot )
+    {
+        const size_t word = slot / kBits;
+        mWords[word]            |= Bit( slot );
+        mSummary[word / kBits]  |= Bit( word );
+    }
+
+
+    void Clear( const size_t slot )
+    {
+        const size_t word = slot / kBits;
+        mWords[word] &= ~Bit( slot );
+        if( 0 == mWords[word] ) { mSummary[word / kBits] &= ~Bit( word ); }
+    }
+
+
+    bool Test( const size_t slot ) const
+    {
+        return 0 != ( mWords[slot / kBits] & Bit( slot ) );
+    }
+
+
+    /**
+     * @brief Returns the lowest occupied slot >= 'slot', or 'kNone'.
+     */
+    size_t NextSet( const size_t slot ) const
+    {
+        size_t word = slot / kBits;
+        if( word >= mWords.size() ) { return kNone; }
+
+        if( const uint64_t bits = mWords[word] & ( ~uint64_t(0) << ( slot % kBits ) ); 0 != bits )
+        {
+            return word * kBits + size_t( std::countr_zero( bits ) );
+        }
+
+        // following words of the same summary word, shifted twice as 'word % kBits' may be 63
+        size_t summary = word / kBits;
+        if( const uint64_t bits = mSummary[summary] & ( ( ~uint64_t(0) << ( word % kBits ) ) << 1 ); 0 != bits )
+        {
+            word = summary * kBits + size_t( std::countr_zero( bits ) );
+            return word * kBits + size_t( std::countr_zero( mWords[word] ) );
+        }
+
+        summary = FindNonZeroWord( mSummary.data(), summary + 1, mSummary.size() );
+        if( summary == mSummary.size() ) { return kNone; }
+
+        word = summary * kBits + size_t( std::countr_zero( mSummary[summary] ) );
+        return word * kBits + size_t( std::countr_zero( mWords[word] ) );
+    }
+
+
+    /**
+     * @brief Returns the highest occupied slot <= 'slot', or 'kNone'. 'slot' may be 'kNone', in
+     *        which case the highest occupied slot is returned.
+     */
+    size_t PrevSet( const size_t slot ) const
+    {
+        if( mWords.empty() ) { return kNone; }
+
+        size_t word  = slot / kBits;
+        uint64_t mask = ~uint64_t(0) >> ( kBits - 1 - slot % kBits );
+        if( word >= mWords.size() )
+        {
+            word = mWords.size() - 1;
+            mask = ~uint64_t(0);
+        }
+
+        if( const uint64_t bits = mWords[word] & mask; 0 != bits )
+        {
+            return word * kBits + HighestBit( bits );
+        }
+
+        // preceding words of the same summary word
+        size_t summary = word / kBits;
+        if( const uint64_t bits = mSummary[summary] & ( Bit( word ) - 1 ); 0 != bits )
+        {
+            word = summary * kBits + HighestBit( bits );
+            return word * kBits + HighestBit( mWords[word] );
+        }
+
+        summary = FindNonZeroWordReverse( mSummary.data(), summary );
+        if( kNone == summary ) { return kNone; }
+
+        word = summary * kBits + HighestBit( mSummary[summary] );
+        return word * kBits + HighestBit( mWords[word] );
+    }
+
+
+private:
+
+    static constexpr size_t kBits = 64;  // Bits per word.
+
+    static uint64_t Bit( const size_t index )
+    {
+        return uint64_t(1) << ( index % kBits );
+    }
+
+    static size_t HighestBit( const uint64_t bits )
+    {
+        return kBits - 1 - size_t( std::countl_zero( bits ) );
+    }
+
+
+    std::pmr::vector<uint64_t> mWords;    // Bit 'i % 64' of word 'i / 64' is set if slot 'i' is occupied.
+    std::pmr::vector<uint64_t> mSummary;  // Bit 'w % 64' of word 'w / 64' is set if 'mWords[w]' is not zero.
+};
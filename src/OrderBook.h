@@ -1,17 +1,35 @@
 #pragma once
-#include <unordered_map>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <queue>
 #include <map>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <iostream>
 
+#include "DepthPublisher.h"
+#include "NodeArena.h"
+#include "OrderBookStats.h"
+#include "OrderIndex.h"
+#include "OrderPool.h"
+#include "PriceLadder.h"
+#include "QueuePositionIndex.h"
+#include "TradeAnalytics.h"
 #include "UniqueIDGenerator.h"
 
-class OrderBook
-{
-public:
+class CommandJournal;
 
+
+/**
+ * @brief Types shared by all 'BasicOrderBook' instantiations.
+ */
+struct OrderBookBase
+{
     enum class Side
     {
         BUY = 0,
@@ -20,11 +38,139 @@ public:
 
 
     /**
-     * @brief Construct a new Order Book
+     * @brief How long an inserted order stays in the book, see 'BasicOrderBook::Insert()'.
+     */
+    enum class TimeInForce : uint8_t
+    {
+        GTC = 0,  // Good till cancel: the part which does not trade right away rests in the book.
+        IOC,      // Immediate or cancel: trades what it can right away, the rest is dropped.
+        FOK,      // Fill or kill: trades its whole volume right away or nothing at all.
+        MARKET    // Like 'IOC', but without a limit price.
+    };
+
+
+    /**
+     * @brief Kind of operation of a 'BasicOrderBook::Command'.
+     */
+    enum class CommandType : uint8_t
+    {
+        INSERT = 0,
+        AMEND,
+        PULL,
+        START_AUCTION,  // See 'StartAuction()'.
+        UNCROSS,        // See 'Uncross()'.
+        CANCEL_OWNER,   // See 'CancelOwner()'.
+        REPRICE         // See 'Reprice()'.
+    };
+
+
+    /**
+     * @brief Tag of the owner (e.g. trader or session) of an order, see 'CancelOwner()'.
+     */
+    using OwnerTag = uint32_t;
+
+    static constexpr OwnerTag kNoOwner  = 0;                                     // Owner of orders inserted without a tag.
+    static constexpr OwnerTag kAnyOwner = std::numeric_limits<OwnerTag>::max();  // Matches all owners, can not be given to 'Insert()'.
+
+
+    /**
+     * @brief Bytes used by an order book, see 'BasicOrderBook::GetMemoryUsage()'. The first four
+     *        fields are allocated from the book's arena and are included in 'arena'.
+     */
+    struct MemoryUsage
+    {
+        size_t orders         = 0;  // Order slab, order ids and free list.
+        size_t order_index    = 0;  // Order id -> order table.
+        size_t price_levels   = 0;  // Price levels and occupancy bitmaps of both sides.
+        size_t touched_levels = 0;  // Price levels changed by the current operation.
+        size_t arena          = 0;  // Memory the arena holds from its upstream memory resource.
+        size_t trades         = 0;  // Executed trades kept when no trade sink is set.
+        size_t book           = 0;  // The order book object itself.
+
+        size_t Total() const { return arena + trades + book; }
+
+        auto operator<=>(const MemoryUsage&) const = default;
+    };
+};
+
+
+/**
+ * @brief Compile time choices of 'OrderBook'. Traits for other instantiations of 'BasicOrderBook'
+ *        must provide the same members.
+ */
+struct DefaultOrderBookTraits
+{
+    using Price    = double;    // Prices of the interface. Floating point prices are converted to a number of ticks, integer prices are a number of ticks.
+    using OrderId  = size_t;    // Ids of orders given to 'Insert()'.
+    using Volume   = size_t;    // Volume of orders, price levels and trades.
+    using Sequence = uint64_t;  // Time priority of resting orders, renumbered when it runs out. A book holds at most 'Sequence' max / 4 + 1 resting orders. With a 32-bit 'Volume' as well, a 32-bit type shrinks every order from 32 to 24 bytes.
+
+    template< class Level, bool kSell >
+    using Ladder = PriceLadder< Level, kSell >;                    // Price levels of one side, see 'PriceLadder.h'.
+
+    template< class Trade >
+    using TradeSink = std::function< void( const Trade& ) >;       // Receives trades, see 'SetTradeSink()'.
+
+    using Stats = DefaultOrderBookStats;                           // 'OrderBookStats' or 'NoOrderBookStats'.
+
+    using QueuePositions = NoQueuePositionIndex;                   // 'QueuePositionIndex' or 'NoQueuePositionIndex', see 'GetQueuePosition()'.
+};
+
+
+/**
+ * @brief Order book of a single symbol, parameterized by 'Traits' (see 'DefaultOrderBookTraits').
+ *        'OrderBook' is the instantiation with the default traits and is compiled into the library.
+ *        Other instantiations include 'OrderBookImpl.h'.
+ */
+template< class Traits >
+class BasicOrderBook : public OrderBookBase
+{
+public:
+
+    using Price    = typename Traits::Price;
+    using OrderId  = typename Traits::OrderId;
+    using Volume   = typename Traits::Volume;
+    using Sequence = typename Traits::Sequence;
+
+    static constexpr size_t kMaxRestingOrders = size_t( std::numeric_limits<Sequence>::max() >> 2 ) + 1;  // Half the time priorities 'Sequence' can hold, see 'Insert()'.
+
+
+    /**
+     * @brief Construct a new Order Book without a price band. Floating point prices are rounded to
+     *        the nearest multiple of an implicit tick of 1e-8 and are never rejected as off tick.
+     *        Prices beyond about +/-4.6e10 do not fit in ticks and throw 'std::out_of_range'.
+     * 
+     * @param symbol_name The name of the symbol the order book will be handling buy and sell orders for.
+     * @param upstream    Memory resource the arena of the order book allocates from, see 'Reset()'.
+     */
+    BasicOrderBook( const std::string& symbol_name, UniqueIDGenerator& id_gen, std::pmr::memory_resource* upstream = std::pmr::get_default_resource() );
+
+
+    /**
+     * @brief Construct a new Order Book with a fixed tick size and price band. Price levels are
+     *        kept in a flat array indexed by tick, making level lookups O(1).
      * 
      * @param symbol_name The name of the symbol the order book will be handling buy and sell orders for.
+     * @param tick_size   Smallest price increment. Prices which are not a multiple of it are rejected.
+     * @param min_price   Lowest price accepted by the order book.
+     * @param max_price   Highest price accepted by the order book.
+     * @param upstream    Memory resource the arena of the order book allocates from, see 'Reset()'.
      */
-    OrderBook( const std::string& symbol_name, UniqueIDGenerator& id_gen );
+    BasicOrderBook( const std::string& symbol_name, UniqueIDGenerator& id_gen, const Price tick_size, const Price min_price, const Price max_price,
+                    std::pmr::memory_resource* upstream = std::pmr::get_default_resource() ) requires std::is_floating_point_v<Price>;
+
+
+    /**
+     * @brief Construct a new Order Book with integer prices, i.e. prices counted in ticks, and a
+     *        fixed price band. Price levels are kept in a flat array indexed by tick.
+     *
+     * @param symbol_name The name of the symbol the order book will be handling buy and sell orders for.
+     * @param min_price   Lowest price accepted by the order book.
+     * @param max_price   Highest price accepted by the order book.
+     * @param upstream    Memory resource the arena of the order book allocates from, see 'Reset()'.
+     */
+    BasicOrderBook( const std::string& symbol_name, UniqueIDGenerator& id_gen, const Price min_price, const Price max_price,
+                    std::pmr::memory_resource* upstream = std::pmr::get_default_resource() ) requires std::is_integral_v<Price>;
 
 
     /**
@@ -32,20 +178,29 @@ public:
      * 
      * @param id     Unique id for order. Id may not be the same as a previously inserted order. Must be handleded by caller!
      * @param side   Buy or sell side.
-     * @param price  Price to sell for or buy at.
+     * @param price  Price to sell for or buy at. Throws 'std::out_of_range' if outside the price band
+     *               and 'std::invalid_argument' if not a multiple of the tick size.
      * @param vol    Number of units.
+     * @param owner  Owner of the order, see 'CancelOwner()'. Throws 'std::invalid_argument' for 'kAnyOwner'.
+     * @param tif    Time in force. Orders other than 'GTC' match directly against the opposite
+     *               side and never enter the book, nor the order id index. During an auction
+     *               they do nothing. The price of 'MARKET' orders is ignored. 'GTC' orders throw
+     *               'std::length_error' if 'kMaxRestingOrders' orders already rest in the book,
+     *               which keeps renumbering the time priorities rare.
      */
-    void Insert( const size_t id, const Side side, const double price, const size_t vol );
+    void Insert( const OrderId id, const Side side, const Price price, const Volume vol, const OwnerTag owner = kNoOwner,
+                 const TimeInForce tif = TimeInForce::GTC );
 
 
     /**
      * @brief Updates an existing order in the order book.
      * 
      * @param id     The id of an existing order to change.
-     * @param price  The new price.
+     * @param price  The new price. Throws 'std::out_of_range' if outside the price band and
+     *               'std::invalid_argument' if not a multiple of the tick size.
      * @param vol    The new volume.
      */
-    void Amend( const size_t id, const double price, const size_t vol );
+    void Amend( const OrderId id, const Price price, const Volume vol );
 
 
     /**
@@ -53,7 +208,190 @@ public:
      * 
      * @param id  The id of the order to remove from the order book.
      */
-    void Pull( const size_t id );
+    void Pull( const OrderId id );
+
+
+    /*
+     * Mass cancels remove the orders of a price level together and drop the emptied levels in
+     * one go instead of pulling order by order. They return the number of removed orders, publish
+     * one delta per removed or changed price level and are journaled as the 'PULL' of every
+     * removed order.
+     */
+
+    /**
+     * @brief Removes all orders of 'owner', e.g. when its session disconnects. Visits all resting
+     *        orders, as orders are not indexed by owner. 'kAnyOwner' removes all orders of the
+     *        order book, like 'CancelSide()' on both sides.
+     */
+    size_t CancelOwner( const OwnerTag owner );
+
+
+    /**
+     * @brief Removes all orders on 'side'.
+     */
+    size_t CancelSide( const Side side );
+
+
+    /**
+     * @brief Removes all orders on 'side' with a price in [min_price, max_price]. The range may
+     *        extend beyond the price band.
+     */
+    size_t CancelPriceRange( const Side side, const Price min_price, const Price max_price );
+
+
+    /**
+     * @brief Moves all orders of 'owner' on 'side' by 'ticks' price ticks, e.g. to shift a quote
+     *        ladder. Moved orders lose their time priority like an amended price, and keep their
+     *        order among each other. Matching, if the book is crossed afterwards, only happens
+     *        once all orders have moved. Throws 'std::out_of_range' and moves nothing if an order
+     *        would leave the price band. A tick is the tick size of the price band constructor,
+     *        or 1e-8 for an order book constructed without one.
+     *
+     * @return Number of moved orders.
+     */
+    size_t Reprice( const Side side, const std::int64_t ticks, const OwnerTag owner = kAnyOwner );
+
+
+    /**
+     * @brief An operation of the order book stored as data, e.g. for queueing.
+     */
+    struct Command
+    {
+        using Type = CommandType;
+
+        Type        type;
+        Side        side;                          // Only used by 'INSERT' and 'REPRICE'.
+        OrderId     id;                            // Only used by 'INSERT', 'AMEND' and 'PULL'.
+        Price       price;                         // Used by 'INSERT' and 'AMEND', number of ticks for 'REPRICE'.
+        Volume      vol;                           // Only used by 'INSERT' and 'AMEND'.
+        OwnerTag    owner { kNoOwner };            // Only used by 'INSERT', 'CANCEL_OWNER' and 'REPRICE'.
+        TimeInForce tif   { TimeInForce::GTC };    // Only used by 'INSERT'.
+
+        auto operator<=>(const Command&) const = default;
+    };
+
+
+    /**
+     * @brief Performs the operation described by 'command'.
+     */
+    void Apply( const Command& command );
+
+
+    /**
+     * @brief Performs 'commands' in order. The result, i.e. trades, time priority, deltas and
+     *        journal records, is the same as calling 'Apply()' for each command, but storage for
+     *        all inserted orders is reserved once up front and the price levels of upcoming
+     *        inserts and the order ids of upcoming amends and pulls are prefetched while the
+     *        current command is processed.
+     *        If a command throws, the commands before it have been applied and the rest are not.
+     */
+    void ApplyBatch( std::span<const Command> commands );
+
+
+    /**
+     * @brief Makes room for 'max_orders' resting orders, so inserting up to that many orders
+     *        never grows the order storage or rehashes the order id index.
+     */
+    void ReserveOrders( const size_t max_orders );
+
+
+    /**
+     * @brief Sizes the order book up front for 'max_orders' resting orders, 'max_levels' price
+     *        levels per side and 'max_trades' trades in the list of trades, so reaching them never
+     *        grows, rehashes or reallocates a container. The list of trades stays on the global
+     *        heap, see 'GetListOfTrades()', and is written once so it does not page fault until it
+     *        holds more than 'max_trades' trades. To avoid page faults of the other containers as
+     *        well, back the order book with a 'HugePageResource'. Needs to be called again after
+     *        'Reset()'.
+     */
+    void Reserve( const size_t max_orders, const size_t max_levels, const size_t max_trades );
+
+
+    /**
+     * @brief Removes all orders and executed trades and releases all memory of the order book's
+     *        arena back to its upstream memory resource in one go, e.g. at the end of a trading
+     *        day. A delta with 0 volume is published for every removed price level. The reset
+     *        is not journaled, start a new journal afterwards.
+     */
+    void Reset();
+
+
+    /**
+     * @brief Result of an auction, see 'Uncross()'.
+     */
+    struct AuctionResult
+    {
+        Price  price;    // Clearing price. 0 if nothing can trade.
+        Volume volume;   // Volume traded at the clearing price.
+        Volume surplus;  // Volume left over on the larger side at the clearing price.
+
+        auto operator<=>(const AuctionResult&) const = default;
+    };
+
+
+    /**
+     * @brief Starts an auction: from now on 'Insert()' and 'Amend()' do not match orders, so the
+     *        book may become crossed, until 'Uncross()' is called.
+     */
+    void StartAuction();
+
+
+    /**
+     * @brief Returns true between 'StartAuction()' and 'Uncross()'.
+     */
+    bool InAuction() const;
+
+
+    /**
+     * @brief Returns the result 'Uncross()' would have if it were called now, without trading.
+     */
+    AuctionResult GetIndicativeUncross() const;
+
+
+    /**
+     * @brief Ends the auction by executing all crossed orders at a single clearing price, found
+     *        in one pass over the cumulative volumes of the crossed price levels. The clearing
+     *        price is the one with the most executable volume, then the smallest surplus, then
+     *        the highest price if buyers are left over and the lowest price otherwise. Orders on
+     *        each side are filled in price/time priority. Of the two orders of a trade, the one
+     *        which entered the book last is reported as the aggressor. Continuous matching
+     *        resumes afterwards. Can also be called outside of an auction.
+     */
+    AuctionResult Uncross();
+
+
+    /**
+     * @brief Appends every command accepted by the order book to 'journal' before it is applied.
+     *        Pass nullptr to stop journaling. The journal must outlive its use by the order book.
+     *        See 'CommandJournal::Replay()' for rebuilding an order book from a journal.
+     */
+    void SetJournal( CommandJournal* journal );
+
+
+    /**
+     * @brief Returns the journal set by 'SetJournal()' or nullptr.
+     */
+    CommandJournal* GetJournal() const;
+
+
+    /**
+     * @brief Writes all resting orders, in time priority within each price level, together with
+     *        the state needed to continue where the order book left off, to a versioned binary
+     *        snapshot. The snapshot is written to a temporary file and renamed to 'path', so an
+     *        existing snapshot is replaced atomically. Throws 'std::system_error' on I/O errors.
+     */
+    void SaveSnapshot( const std::string& path ) const;
+
+
+    /**
+     * @brief Restores the resting orders from a snapshot written by 'SaveSnapshot()'. The order
+     *        book must be empty and use the same tick size as the one that wrote the snapshot.
+     *        The 'UniqueIDGenerator' is advanced past the trade IDs used before the snapshot, and
+     *        an order book saved during an auction stays in the auction until 'Uncross()'.
+     *        Executed trades, the trade statistics and the trade bars are not part of a snapshot,
+     *        they start from zero as in a new order book.
+     */
+    void LoadSnapshot( const std::string& path );
 
 
     /**
@@ -61,19 +399,107 @@ public:
      */
     struct ExecutedTrade
     {
-        double price;                // Price which resulted in trade.
-        size_t volume;               // Number of units traded.
-        size_t aggressive_order_id;  // The id of the order which triggered the trade. Can be sell or buy order type.
-        size_t passive_order_id;     // The id of the order which matched with the above order. Opposite order type of the above order.
-        size_t trade_id;             // The id of the trade. Can be used for ordering trades accross multiple order books depending on 'id_gen'.
+        Price   price;               // Price which resulted in trade.
+        Volume  volume;              // Number of units traded.
+        OrderId aggressive_order_id; // The id of the order which triggered the trade. Can be sell or buy order type.
+        OrderId passive_order_id;    // The id of the order which matched with the above order. Opposite order type of the above order.
+        size_t  trade_id;            // The id of the trade. Can be used for ordering trades accross multiple order books depending on 'id_gen'.
 
         auto operator<=>(const ExecutedTrade&) const = default;
     };
 
     /**
-     * @brief Returns the list of executed trades
+     * @brief Returns the list of executed trades. Only filled while no trade sink is set, see 'SetTradeSink()'.
+     */
+    const std::vector< ExecutedTrade >& GetListOfTrades();
+
+
+    /**
+     * @brief Called once for every executed trade, from within 'Insert()' and 'Amend()'.
+     */
+    using TradeSink = typename Traits::template TradeSink< ExecutedTrade >;
+
+
+    /**
+     * @brief Streams executed trades to 'sink' instead of storing them in the list returned by
+     *        'GetListOfTrades()'. Passing an empty sink goes back to storing trades in the list.
+     *        E.g. a 'SpscRingBuffer<ExecutedTrade>' can be used to hand trades to a consumer thread
+     *        with bounded memory.
      */
-    const std::vector< OrderBook::ExecutedTrade >& GetListOfTrades();
+    void SetTradeSink( TradeSink sink );
+
+
+    /**
+     * @brief Makes the order book reserve trade IDs from its 'UniqueIDGenerator' in blocks of
+     *        'block_size', so order books running on different threads do not contend on the
+     *        shared generator for every trade. The default block size of 1 keeps trade IDs
+     *        ordered across all order books sharing the generator.
+     */
+    void SetTradeIDBlockSize( const size_t block_size );
+
+
+    /**
+     * @brief Running statistics of all trades since construction or the last 'Reset()'.
+     */
+    struct TradeSummary
+    {
+        Price    open     = 0;  // Price of the first trade.
+        Price    high     = 0;  // Highest trade price.
+        Price    low      = 0;  // Lowest trade price.
+        Price    last     = 0;  // Price of the latest trade.
+        uint64_t volume   = 0;  // Total volume traded.
+        double   notional = 0;  // Sum of price times volume of all trades.
+        double   vwap     = 0;  // Volume weighted average price, i.e. 'notional / volume'.
+        uint64_t trades   = 0;  // Number of trades.
+
+        auto operator<=>(const TradeSummary&) const = default;
+    };
+
+
+    /**
+     * @brief Returns the trade statistics in O(1). They are updated on every trade, whether trades
+     *        go to a trade sink or to the list of trades.
+     */
+    TradeSummary GetTradeSummary() const;
+
+
+    /**
+     * @brief Open, high, low and close price and volume of the trades in one time interval.
+     */
+    struct TradeBar
+    {
+        uint64_t start  = 0;  // Start of the interval, in nanoseconds of the trade clock.
+        Price    open   = 0;
+        Price    high   = 0;
+        Price    low    = 0;
+        Price    close  = 0;
+        uint64_t volume = 0;
+        uint64_t trades = 0;
+
+        auto operator<=>(const TradeBar&) const = default;
+    };
+
+
+    /**
+     * @brief Returns the current time in nanoseconds, see 'SetTradeBars()'.
+     */
+    using TradeClock = std::function< uint64_t() >;
+
+
+    /**
+     * @brief Keeps a bar for each of the latest 'count' intervals of 'interval_ns' which had
+     *        trades, in a ring allocated right away. The time of a trade is read from 'clock',
+     *        which defaults to the system clock. A 'count' of 0 stops keeping bars.
+     */
+    void SetTradeBars( const uint64_t interval_ns, const size_t count, TradeClock clock = {} );
+
+
+    /**
+     * @brief Writes the bars kept, oldest first, into 'out' without allocating.
+     *
+     * @return Number of bars written to 'out'. If 'out' is too small, only the newest bars are written.
+     */
+    size_t GetTradeBars( std::span<TradeBar> out ) const;
 
 
     /**
@@ -82,12 +508,12 @@ public:
     struct PriceLevel
     {
         // The total volume for a specific buy price
-        double buy_price = 0.0;
-        size_t buy_vol   = 0;
+        Price  buy_price = 0;
+        Volume buy_vol   = 0;
 
         // The total volume for the sell price closest to the above buy price
-        double sell_price = 0.0;
-        size_t sell_vol   = 0;
+        Price  sell_price = 0;
+        Volume sell_vol   = 0;
 
         auto operator<=>(const PriceLevel&) const = default;
     };
@@ -99,44 +525,505 @@ public:
      *        set to 0 volume and price. Sorted in increasing sell price.
      */
     std::vector< PriceLevel > GetPriceLevels();
+
+
+    /**
+     * @brief Returns the best buy and sell price levels. A side without orders is set to 0 volume and price.
+     */
+    PriceLevel GetTopOfBook() const;
+
+
+    /**
+     * @brief Writes up to 'n' price levels, best prices first, into 'out' without allocating.
+     *        Levels are paired up the same way as in 'GetPriceLevels()'.
+     * 
+     * @param n    Maximum number of price levels to write.
+     * @param out  Caller provided storage. At most 'out.size()' levels are written.
+     * @return     Number of price levels written to 'out'.
+     */
+    size_t GetDepth( const size_t n, std::span<PriceLevel> out ) const;
+
+
+    /**
+     * @brief Position of a resting order in the time priority queue of its price level.
+     */
+    struct QueuePosition
+    {
+        Side   side;          // Side of the order.
+        Price  price;         // Price of the order.
+        Volume vol;           // Remaining volume of the order.
+        Volume volume_ahead;  // Total volume of the orders at the same price with time priority over it.
+        size_t orders_ahead;  // Number of those orders.
+
+        auto operator<=>(const QueuePosition&) const = default;
+    };
+
+
+    /**
+     * @brief Looks up where the resting order 'id' is in the queue of its price level. Takes
+     *        O(log n) in the number of orders at that price if 'Traits::QueuePositions' is
+     *        'QueuePositionIndex'. The index slows down every change of a price level, so
+     *        'OrderBook' uses 'NoQueuePositionIndex' and walks the orders ahead in O(n) instead.
+     *        Traits deriving from 'DefaultOrderBookTraits' with 'QueuePositions' set to
+     *        'QueuePositionIndex' opt in to the logarithmic lookup.
+     *
+     * @return False if no order 'id' rests in the book, in which case 'position' is unchanged.
+     */
+    bool GetQueuePosition( const OrderId id, QueuePosition& position ) const;
+
+
+    /**
+     * @brief Resting order as seen through 'LevelOrders'.
+     */
+    struct OrderView
+    {
+        OrderId  id;
+        Volume   vol;
+        OwnerTag owner;
+
+        auto operator<=>(const OrderView&) const = default;
+    };
+
+
+    /**
+     * @brief The resting orders of one price level in time priority order, read in place from the
+     *        order book. Valid until the next operation which changes the order book.
+     */
+    class LevelOrders
+    {
+    public:
+
+        class Iterator
+        {
+        public:
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = OrderView;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = OrderView;
+
+            Iterator() = default;
+
+            OrderView operator*() const
+            {
+                const OrderInfo& info = mBook->mPool.GetCold( mHandle );
+                return OrderView{ info.id, mBook->mPool[mHandle].vol, info.owner };
+            }
+
+            Iterator& operator++()    { mHandle = mBook->mPool[mHandle].next; return *this; }
+            Iterator  operator++(int) { Iterator it = *this; ++*this; return it; }
+
+            bool operator==( const Iterator& other ) const { return mHandle == other.mHandle; }
+
+        private:
+
+            friend class LevelOrders;
+
+            Iterator( const BasicOrderBook* book, const OrderQueue::Handle handle )
+            : mBook { book }, mHandle { handle }
+            {
+            }
+
+            const BasicOrderBook* mBook   { nullptr };
+            OrderQueue::Handle    mHandle { OrderQueue::kNil };
+        };
+
+        Side   side  = Side::BUY;
+        Price  price = 0;
+        Volume vol   = 0;  // Total volume of the orders.
+        size_t count = 0;  // Number of orders.
+
+        Iterator begin() const { return Iterator( mBook, mHead ); }
+        Iterator end()   const { return Iterator( mBook, OrderQueue::kNil ); }
+        bool     empty() const { return OrderQueue::kNil == mHead; }
+
+    private:
+
+        friend class BasicOrderBook;
+
+        const BasicOrderBook* mBook { nullptr };
+        OrderQueue::Handle    mHead { OrderQueue::kNil };
+    };
+
+
+    /**
+     * @brief Returns the orders resting at 'price' on 'side', an empty range if there are none.
+     */
+    LevelOrders GetLevelOrders( const Side side, const Price price ) const;
+
+
+    /**
+     * @brief Calls 'fn' with the 'LevelOrders' of every price level of 'side', best price first,
+     *        until 'fn' returns false. Gives the full market by order view without copying.
+     */
+    template< class Fn >
+    void ForEachLevel( const Side side, Fn&& fn ) const
+    {
+        WithSide( Side::SELL == side, [&]( const auto& queue )
+        {
+            queue.ForEach( [&]( const Tick tick, const Level& level )
+            {
+                return fn( MakeLevelOrders( side, tick, level ) );
+            } );
+        } );
+    }
+
+
+    /**
+     * @brief New state of a price level after an operation on the order book.
+     */
+    struct LevelDelta
+    {
+        uint64_t seq;    // Sequence number of the delta, starts at 1 and increases by one for each delta of the order book.
+        Side     side;   // Side of the price level.
+        Price    price;  // Price of the price level.
+        Volume   vol;    // New total volume at the price. 0 if the price level has been removed.
+        size_t   count;  // New number of orders at the price.
+
+        auto operator<=>(const LevelDelta&) const = default;
+    };
+
+    /**
+     * @brief Called once for every price level that changed during an 'Insert()', 'Amend()' or 'Pull()'.
+     */
+    using DeltaSink = std::function< void( const LevelDelta& ) >;
+
+
+    /**
+     * @brief Publishes price level changes to 'sink'. Changes are coalesced per operation, so each
+     *        touched price level results in a single delta, no matter how many fills it took part in.
+     */
+    void SetDeltaSink( DeltaSink sink );
+
+
+    /**
+     * @brief Top levels of the book for reader threads, see 'SetDepthPublisher()'.
+     */
+    using DepthPublisher = ::DepthPublisher< PriceLevel >;
+
+
+    /**
+     * @brief Publishes the best 'publisher->MaxLevels()' price levels, as returned by 'GetDepth()',
+     *        to 'publisher' right away and after every operation which changed a price level.
+     *        Other threads may read them from 'publisher' at any time without locking the order
+     *        book. Pass nullptr to stop publishing. The publisher must outlive its use by the book.
+     */
+    void SetDepthPublisher( DepthPublisher* publisher );
+
+
+    /**
+     * @brief Returns the latency percentiles of the hot path operations and the matching and price
+     *        level counters. May be called from any thread while the order book is in use. All
+     *        values stay 0 unless the library is built with 'ORDERBOOK_ENABLE_STATS'.
+     */
+    OrderBookStatsSnapshot GetStats() const;
+
+
+    /**
+     * @brief Returns the bytes used by the order book, broken down by container. Sizes are
+     *        capacities, i.e. what is allocated rather than what is in use.
+     */
+    MemoryUsage GetMemoryUsage() const;
     
         void PrintOrderBook();
 
 
 private:
 
+    using Tick = std::int64_t;  // Price expressed as a whole number of ticks.
+
+    /**
+     * @brief Converts a price to ticks. Throws 'std::out_of_range' if the price is outside the price band
+     *        and 'std::invalid_argument' if it is off tick in an order book constructed with a tick size.
+     */
+    Tick ToTick( const Price price ) const;
+
+
+    /**
+     * @brief Same as 'ToTick()', but returns false instead of throwing.
+     */
+    bool TryToTick( const Price price, Tick& tick ) const;
+
+
+    /**
+     * @brief Converts ticks back to a price.
+     */
+    Price ToPrice( const Tick tick ) const;
+
+
     /**
      * @brief Goes through the sell and buy orders and matches orders
      */
     void ExecuteOrders();
 
 
+    /**
+     * @brief Trades an incoming 'IOC', 'FOK' or 'MARKET' order against the opposite side without
+     *        adding it to the book.
+     */
+    void ExecuteImmediately( const OrderId id, const bool sell, const Tick limit, Volume vol, const TimeInForce tif );
+
+
+    /**
+     * @brief Hands 'trade', which happened at 'tick', to the trade sink or the list of trades and
+     *        adds it to the trade statistics.
+     */
+    void EmitTrade( const ExecutedTrade& trade, const Tick tick );
+
+
+    /**
+     * @brief Trades 'tradeVol' between the first orders of the best buy and sell price levels at 'price'.
+     *        Removes orders and price levels which are left without volume.
+     */
+    void MatchBestOrders( const Tick price, const Volume tradeVol );
+
+
+    /**
+     * @brief Computes the auction result for the current book and its clearing price in ticks.
+     */
+    AuctionResult ComputeUncross( Tick& price ) const;
+
+
+    /**
+     * @brief Marks the price level at 'tick' as changed by the current operation.
+     */
+    void TouchLevel( const bool sell, const Tick tick );
+
+
+    /**
+     * @brief Sends a delta for every price level touched by the current operation to the delta sink.
+     */
+    void PublishDeltas();
+
+
+    /**
+     * @brief Writes the current top levels to the depth publisher.
+     */
+    void PublishDepth();
+
+
+    /**
+     * @brief Removes the orders and price levels with ticks in [first, last] on one side.
+     */
+    size_t CancelLevels( const bool sell, const Tick first, const Tick last );
+
+
+    /**
+     * @brief Journals the 'PULL' of every order of 'owner' with ticks in [first, last] on one side.
+     *        Mass cancels call it before removing anything, so a throwing journal leaves the order
+     *        book untouched.
+     */
+    void JournalPulls( const bool sell, const Tick first, const Tick last, const OwnerTag owner );
+
+
+    /**
+     * @brief Hints the CPU to load the price level the insert 'command' will add to into the cache.
+     */
+    void PrefetchLevel( const Command& command ) const;
+
+
+    /**
+     * @brief Returns the time priority for an order entering its price level now. If 'Sequence'
+     *        has run out of internal ids, the priorities of all resting orders are renumbered
+     *        first, keeping their order.
+     */
+    Sequence NextPriority( const bool sell );
+
+
+    /**
+     * @brief Gives the resting orders the internal ids 0, 1, ... in time priority order. At most
+     *        'kMaxRestingOrders' orders rest, so at least as many ids are free afterwards.
+     */
+    void RenumberPriorities();
+
+
+    /**
+     * @brief Returns true if trades go to 'mTradeSink' rather than 'mExecutedTrades'. Always true
+     *        for sinks which can not be empty.
+     */
+    bool HasTradeSink() const
+    {
+        if constexpr( std::is_constructible_v<bool, const TradeSink&> ) { return bool( mTradeSink ); }
+        else                                                            { return true; }
+    }
+
+
+    /**
+     * @brief Calls 'fn' with the price levels of the sell side if 'sell', otherwise with those of
+     *        the buy side. Everything inside 'fn' is compiled for one side.
+     */
+    template< class Fn >
+    decltype(auto) WithSide( const bool sell, Fn&& fn )
+    {
+        return sell ? fn( mSellQueue ) : fn( mBuyQueue );
+    }
+
+    template< class Fn >
+    decltype(auto) WithSide( const bool sell, Fn&& fn ) const
+    {
+        return sell ? fn( mSellQueue ) : fn( mBuyQueue );
+    }
+
+
     /**
      * @brief Active order which is waiting to be matched with another order
      */
     struct Order
     {
-        size_t id;     // global order id (the one from 'Insert()' method)
-        size_t intId;  // internal order book id (used for prioritization)
-        double price;  // price which will trigger a trade
-        size_t vol;    // number of units which will be traded
-        bool   sell;   // sell or buy order
+        Tick     price;     // price in ticks which will trigger a trade
+        Volume   vol;       // number of units which will be traded
+        Sequence priority;  // internal order book id shifted left by one (used for prioritization), lowest bit set for sell orders
+
+        OrderQueue::Handle prev;  // previous order at the same price (intrusive FIFO link)
+        OrderQueue::Handle next;  // next order at the same price (intrusive FIFO link)
+
+        bool   Sell()  const { return 0 != ( priority & 1 ); }
+        size_t IntId() const { return size_t( priority >> 1 ); }
+
+        void print( const OrderId id ) const
+        {
+            std::cout << "[" << id << "|" << price << "|" << vol << "|" << IntId() << "] x ";
+        }
+    };
+
+
+    /**
+     * @brief Part of an order which matching does not need, see 'OrderPool'.
+     */
+    struct OrderInfo
+    {
+        OrderId  id;          // global order id (the one from 'Insert()' method)
+        OwnerTag owner;       // owner given to 'Insert()'
+        uint32_t slot { 0 };  // slot of the order in 'Level::positions'
+    };
+
+
+    /**
+     * @brief All orders at one price, sorted after 'time priority', and their running totals.
+     *        Allocator aware, so the queue positions live in the memory resource of the ladder.
+     */
+    struct Level : OrderQueue
+    {
+        using allocator_type = std::pmr::polymorphic_allocator<>;
 
-        void print()
+        Volume vol   { 0 };  // total volume of all orders at this price
+        size_t count { 0 };  // number of orders at this price
+        [[no_unique_address]] typename Traits::QueuePositions positions;  // volume and orders ahead of every order
+
+        Level() = default;
+        Level( const Level& ) = default;
+        Level( Level&& ) = default;
+        Level& operator=( const Level& ) = default;
+        Level& operator=( Level&& ) = default;
+
+        explicit Level( const allocator_type& alloc )
+        : positions { alloc }
+        {
+        }
+
+        Level( const Level& other, const allocator_type& alloc )
+        : OrderQueue { other }, vol { other.vol }, count { other.count }, positions { other.positions, alloc }
+        {
+        }
+
+        Level( Level&& other, const allocator_type& alloc )
+        : OrderQueue { other }, vol { other.vol }, count { other.count }, positions { std::move( other.positions ), alloc }
         {
-            std::cout << "[" << id << "|" << price << "|" << vol << "|" << intId << "] x ";
         }
+
+
+        /**
+         * @brief Appends the order 'handle' to the back of the queue and adds it to the totals.
+         */
+        void Append( OrderPool<Order, OrderInfo>& pool, const OrderQueue::Handle handle );
+
+
+        /**
+         * @brief Unlinks the order 'handle' from the queue and takes it off the totals.
+         */
+        void Remove( OrderPool<Order, OrderInfo>& pool, const OrderQueue::Handle handle );
+
+
+        /**
+         * @brief Takes 'by' off the order 'handle', which stays in its place in the queue.
+         */
+        void Reduce( OrderPool<Order, OrderInfo>& pool, const OrderQueue::Handle handle, const Volume by );
     };
 
 
+    /**
+     * @brief Returns the view of the orders of 'level', which is at 'tick' on 'side'.
+     */
+    LevelOrders MakeLevelOrders( const Side side, const Tick tick, const Level& level ) const
+    {
+        LevelOrders orders;
+        orders.side  = side;
+        orders.price = ToPrice( tick );
+        orders.vol   = level.vol;
+        orders.count = level.count;
+        orders.mBook = this;
+        orders.mHead = level.head;
+        return orders;
+    }
+
+
+    using Handle = OrderQueue::Handle;                       // Refers to an order in 'mPool'.
+
+    static constexpr size_t kMaxIntId = size_t( std::numeric_limits<Sequence>::max() >> 1 );  // Largest internal order id 'Order::priority' can hold.
+
+    static constexpr double kDefaultTickSize = std::is_floating_point_v<Price> ? 1e-8 : 1.0;  // Tick size used when no price band is given.
+
     const std::string mSymbol;                               // Symbol of order book.
+    const double mTicksPerUnit;                              // Number of ticks per whole price unit, i.e. 1 / tick size.
+    const bool mOnTickOnly { true };                         // Prices must be a multiple of the tick size, false for the default tick size.
     UniqueIDGenerator& mIdGen;                               // used for generating IDs for executed trades.
+    IDBlockLease mTradeIds { mIdGen };                       // Trade IDs reserved from 'mIdGen'.
     size_t mIntId { 0 };                                     // Used for giving orders 'time priority'.
-    std::unordered_map<size_t, Order> mOrders;               // Contains all sell and buy orders. Maps 'order id' -> 'order'. Used for looking up orders when doing 'Amend()' operations.
-    std::vector<ExecutedTrade> mExecutedTrades;              // Contains all matched orders which resulted in a trade.
+    NodeArena mArena;                                        // Backs all orders, price levels and the order index of this book.
+    OrderPool<Order, OrderInfo> mPool { &mArena };           // Storage of all sell and buy orders, ids and owners are kept apart as the cold part.
+    BasicOrderIndex<OrderId> mOrders { &mArena };            // Maps 'order id' -> 'order handle'. Used for looking up orders when doing 'Amend()' and 'Pull()' operations.
+    std::vector<ExecutedTrade> mExecutedTrades;              // Contains all matched orders which resulted in a trade, unless 'mTradeSink' is set.
+    TradeSink mTradeSink;                                    // Receives executed trades if set.
+    CommandJournal* mJournal { nullptr };                    // Receives accepted commands if set.
+    TradeAnalytics mTradeAnalytics;                          // Running trade statistics and bars, in ticks.
+    TradeClock mTradeClock;                                  // Time of trades for the bars, see 'SetTradeBars()'.
+    bool mInAuction { false };                               // Orders are not matched until 'Uncross()' if true.
+
+    /**
+     * @brief A price level changed by the current operation.
+     */
+    struct TouchedLevel
+    {
+        bool sell;
+        Tick tick;
+    };
+
+    /**
+     * @brief The levels of one side changed by the current operation, see 'TouchLevel()'.
+     */
+    struct TouchedSide
+    {
+        Tick last     { 0 };      // Level touched last on this side.
+        bool any      { false };  // At least one level of this side was touched.
+        bool in_order { true };   // All levels of this side were touched moving away from the spread.
+    };
+
+    DeltaSink mDeltaSink;                                    // Receives price level changes if set.
+    uint64_t mDeltaSeq { 0 };                                // Sequence number of the last published delta.
+    std::pmr::vector<TouchedLevel> mTouched { &mArena };     // Price levels changed by the current operation, in order of first change.
+    std::pmr::vector<Handle> mRenumbered { &mArena };        // Resting orders sorted by 'RenumberPriorities()', kept to reuse the memory.
+    TouchedSide mTouchedSides[2];                            // Buy side at index 0, sell side at index 1.
+    DepthPublisher* mDepthPublisher { nullptr };             // Receives the top levels after every operation if set.
+    std::vector<PriceLevel> mDepth;                          // Scratch buffer for 'PublishDepth()'.
+
+    typename Traits::template Ladder<Level, true>  mSellQueue;  // All sell orders. Given a sell price in ticks, will return all active sell orders sorted after 'time priority'.
+    typename Traits::template Ladder<Level, false> mBuyQueue;   // Same as 'mSellQueue' but for buy orders.
+
+    [[no_unique_address]] typename Traits::Stats mStats;     // Latency histograms and counters, see 'GetStats()'.
+};
+
 
-    std::map< double, std::map<size_t, Order> > mSellQueue;  // All sell orders. Given a sell price, will return all active sell orders sorted after 'time priority'.
-    std::map< double, std::map<size_t, Order> > mBuyQueue;   // Same as 'mSellQueue' but for buy orders.
+using OrderBook = BasicOrderBook< DefaultOrderBookTraits >;
 
-    std::map< double, std::map<size_t, Order> >* mQueues[2] { &mBuyQueue, &mSellQueue };
-};
\ No newline at end of file
+extern template class BasicOrderBook< DefaultOrderBookTraits >;
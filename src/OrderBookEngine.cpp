@@ -0,0 +1,201 @@
+#include "OrderBookEngine.h"
+
+#include <exception>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+OrderBookEngine::OrderBookEngine( const size_t num_shards, UniqueIDGenerator& id_gen, const size_t queue_capacity, const bool pin_threads )
+: mIdGen      { id_gen },
+  mPinThreads { pin_threads }
+{
+    if( 0 == num_shards )
+    {
+        throw std::invalid_argument( "OrderBookEngine: at least one shard is required" );
+    }
+
+    for( size_t i = 0; i < num_shards; ++i )
+    {
+        mShards.push_back( std::make_unique<Shard>( queue_capacity ) );
+    }
+}
+
+
+OrderBookEngine::~OrderBookEngine()
+{
+    Stop();
+}
+
+
+size_t OrderBookEngine::AddSymbol( const std::string& symbol_name )
+{
+    return AddBook( std::make_unique<OrderBook>( symbol_name, mIdGen ) );
+}
+
+
+size_t OrderBookEngine::AddSymbol( const std::string& symbol_name, const double tick_size, const double min_price, const double max_price )
+{
+    return AddBook( std::make_unique<OrderBook>( symbol_name, mIdGen, tick_size, min_price, max_price ) );
+}
+
+
+size_t OrderBookEngine::AddBook( std::unique_ptr<OrderBook> book )
+{
+    if( mRunning.load() )
+    {
+        throw std::logic_error( "OrderBookEngine: symbols must be added before the engine is started" );
+    }
+
+    const size_t symbol = mBooks.size();
+    Shard&       shard  = *mShards[ symbol % mShards.size() ];
+
+    // only the shard's worker thread executes trades for this book, so it is the single producer
+    book->SetTradeSink( [this, &shard, symbol]( const OrderBook::ExecutedTrade& trade )
+    {
+        std::chrono::steady_clock::time_point stalled_since {};
+
+        while( !shard.trades.TryPush( Trade{ symbol, trade } ) )
+        {
+            // once stopping, a poller may still be draining the queue, so only give up on it after nothing
+            // was taken for a while. The fill is already in the book so it is counted.
+            if( !mRunning.load( std::memory_order_relaxed ) )
+            {
+                const auto now = std::chrono::steady_clock::now();
+                if( stalled_since == std::chrono::steady_clock::time_point{} ) { stalled_since = now; }
+
+                if( shard.abandoned || now - stalled_since > kDrainTimeout )
+                {
+                    shard.abandoned = true;
+                    shard.dropped.fetch_add( 1, std::memory_order_relaxed );
+                    return;
+                }
+            }
+
+            std::this_thread::yield();
+        }
+    } );
+
+    mBooks.push_back( std::move(book) );
+    mBookShard.push_back( symbol % mShards.size() );
+
+    return symbol;
+}
+
+
+void OrderBookEngine::Start()
+{
+    if( mRunning.exchange( true ) ) { return; }
+
+    for( size_t i = 0; i < mShards.size(); ++i )
+    {
+        Shard& shard = *mShards[i];
+        shard.abandoned = false;
+        shard.thread = std::thread( [this, &shard] { Run( shard ); } );
+
+#ifdef __linux__
+        if( mPinThreads )
+        {
+            cpu_set_t cpus;
+            CPU_ZERO( &cpus );
+            CPU_SET( i % std::max( 1u, std::thread::hardware_concurrency() ), &cpus );
+            pthread_setaffinity_np( shard.thread.native_handle(), sizeof(cpus), &cpus );
+        }
+#endif
+    }
+}
+
+
+void OrderBookEngine::Stop()
+{
+    if( !mRunning.exchange( false ) ) { return; }
+
+    for( auto& shard : mShards )
+    {
+        shard->thread.join();
+    }
+}
+
+
+bool OrderBookEngine::Submit( const size_t symbol, const OrderBook::Command& command )
+{
+    return mShards[ mBookShard[symbol] ]->commands.TryPush( Inbound{ symbol, command } );
+}
+
+
+bool OrderBookEngine::PollTrade( const size_t shard, Trade& trade )
+{
+    return mShards[shard]->trades.TryPop( trade );
+}
+
+
+size_t OrderBookEngine::GetRejectedCount( const size_t shard ) const
+{
+    return mShards[shard]->rejected.load( std::memory_order_relaxed );
+}
+
+
+size_t OrderBookEngine::GetDroppedTradeCount( const size_t shard ) const
+{
+    return mShards[shard]->dropped.load( std::memory_order_relaxed );
+}
+
+
+size_t OrderBookEngine::GetShard( const size_t symbol ) const
+{
+    return mBookShard[symbol];
+}
+
+
+size_t OrderBookEngine::GetShardCount() const
+{
+    return mShards.size();
+}
+
+
+OrderBook& OrderBookEngine::GetBook( const size_t symbol )
+{
+    return *mBooks[symbol];
+}
+
+
+void OrderBookEngine::Run( Shard& shard )
+{
+    constexpr size_t kSpinsBeforeYield = 1024;
+
+    Inbound inbound;
+    size_t  idle_spins = 0;
+
+    while( true )
+    {
+        if( shard.commands.TryPop( inbound ) )
+        {
+            idle_spins = 0;
+
+            try
+            {
+                mBooks[inbound.symbol]->Apply( inbound.command );
+            }
+            catch( const std::exception& )
+            {
+                shard.rejected.fetch_add( 1, std::memory_order_relaxed );
+            }
+
+            continue;
+        }
+
+        // queue is empty, only stop once everything submitted before 'Stop()' has been processed
+        if( !mRunning.load( std::memory_order_acquire ) && 0 == shard.commands.Size() )
+        {
+            return;
+        }
+
+        if( ++idle_spins > kSpinsBeforeYield )
+        {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "OrderBook.h"
+#include "SpscRingBuffer.h"
+#include "UniqueIDGenerator.h"
+
+/**
+ * @brief Runs many order books spread over a number of shards. Each shard owns a worker thread,
+ *        optionally pinned to a core, which is the only thread touching the order books of that
+ *        shard. Commands are handed to the shards and trades are handed back through lock free
+ *        single producer single consumer queues, so no locks are taken on any order book.
+ *
+ * Symbols must be added before 'Start()'. Commands must be submitted from one thread, trades of a
+ * shard must be polled from one thread.
+ */
+class OrderBookEngine
+{
+public:
+
+    /**
+     * @brief A trade executed by one of the order books of the engine.
+     */
+    struct Trade
+    {
+        size_t                   symbol;  // Index returned by 'AddSymbol()'.
+        OrderBook::ExecutedTrade trade;
+    };
+
+
+    /**
+     * @brief Construct a new engine. Worker threads are not started until 'Start()' is called.
+     *
+     * @param num_shards      Number of worker threads. At least one.
+     * @param id_gen          Used for generating IDs for executed trades of all order books.
+     * @param queue_capacity  Capacity of each command and trade queue.
+     * @param pin_threads     Pin shard 'n' to core 'n' modulo the number of cores (Linux only).
+     */
+    OrderBookEngine( const size_t num_shards, UniqueIDGenerator& id_gen, const size_t queue_capacity = 1 << 16, const bool pin_threads = true );
+
+
+    /**
+     * @brief Stops the worker threads, see 'Stop()'.
+     */
+    ~OrderBookEngine();
+
+    OrderBookEngine( const OrderBookEngine& ) = delete;
+    OrderBookEngine& operator=( const OrderBookEngine& ) = delete;
+
+
+    /**
+     * @brief Adds an order book for 'symbol_name', see the 'OrderBook' constructors. Symbols are
+     *        assigned to shards round robin. May only be called before 'Start()'.
+     *
+     * @return Index of the symbol, used for submitting commands.
+     */
+    size_t AddSymbol( const std::string& symbol_name );
+    size_t AddSymbol( const std::string& symbol_name, const double tick_size, const double min_price, const double max_price );
+
+
+    /**
+     * @brief Starts the worker threads.
+     */
+    void Start();
+
+
+    /**
+     * @brief Waits until all submitted commands have been processed and stops the worker threads.
+     *        Poll the trades while stopping to receive all of them. Once nothing has been taken
+     *        from a full trade queue for 'kDrainTimeout' while stopping, the remaining trades of
+     *        that shard are dropped and counted, see 'GetDroppedTradeCount()'.
+     */
+    void Stop();
+
+
+    /**
+     * @brief Queues 'command' for the order book of 'symbol'. Commands for the same symbol are
+     *        processed in the order they are submitted.
+     *
+     * @return False if the queue of the symbol's shard is full, in which case nothing is queued.
+     */
+    bool Submit( const size_t symbol, const OrderBook::Command& command );
+
+
+    /**
+     * @brief Takes the oldest trade of 'shard' from its trade queue.
+     *
+     * @return False if there are no trades, in which case 'trade' is left unchanged.
+     */
+    bool PollTrade( const size_t shard, Trade& trade );
+
+
+    static constexpr std::chrono::milliseconds kDrainTimeout { 100 };  // See 'Stop()'.
+
+
+    /**
+     * @brief Returns the number of commands of 'shard' which were rejected by the order book,
+     *        e.g. because the price was outside of the price band.
+     */
+    size_t GetRejectedCount( const size_t shard ) const;
+
+
+    /**
+     * @brief Returns the number of trades of 'shard' which were executed by the order books but
+     *        dropped because the trade queue was full while stopping, see 'Stop()'.
+     */
+    size_t GetDroppedTradeCount( const size_t shard ) const;
+
+
+    /**
+     * @brief Returns the shard the order book of 'symbol' is assigned to.
+     */
+    size_t GetShard( const size_t symbol ) const;
+
+
+    /**
+     * @brief Returns the number of shards.
+     */
+    size_t GetShardCount() const;
+
+
+    /**
+     * @brief Returns the order book of 'symbol'. Must not be used while the engine is running.
+     */
+    OrderBook& GetBook( const size_t symbol );
+
+
+private:
+
+    /**
+     * @brief A command and the order book it is for.
+     */
+    struct Inbound
+    {
+        size_t             symbol;
+        OrderBook::Command command;
+    };
+
+
+    /**
+     * @brief Worker thread and its queues.
+     */
+    struct Shard
+    {
+        explicit Shard( const size_t queue_capacity )
+        : commands { queue_capacity },
+          trades   { queue_capacity }
+        {
+        }
+
+        SpscRingBuffer<Inbound> commands;        // Commands for the order books of this shard.
+        SpscRingBuffer<Trade>   trades;          // Trades executed by the order books of this shard.
+        std::atomic<size_t>     rejected { 0 };  // Commands which threw an exception.
+        std::atomic<size_t>     dropped  { 0 };  // Trades which did not fit into 'trades' while stopping.
+        bool                    abandoned { false };  // Nobody drained 'trades' while stopping, only used by 'thread'.
+        std::thread             thread;          // Worker thread, the only thread touching the order books of this shard.
+    };
+
+
+    /**
+     * @brief Adds 'book' to the next shard and returns its symbol index.
+     */
+    size_t AddBook( std::unique_ptr<OrderBook> book );
+
+
+    /**
+     * @brief Main loop of the worker thread of 'shard'.
+     */
+    void Run( Shard& shard );
+
+
+    UniqueIDGenerator& mIdGen;                         // Used for generating IDs for executed trades.
+    const bool mPinThreads;                            // Pin worker threads to cores.
+    std::vector< std::unique_ptr<Shard> > mShards;     // All shards.
+    std::vector< std::unique_ptr<OrderBook> > mBooks;  // All order books, indexed by symbol.
+    std::vector< size_t > mBookShard;                  // Shard index of each order book.
+    std::atomic<bool> mRunning { false };              // Worker threads keep running while true.
+};
@@ -0,0 +1,1553 @@
+#pragma once
+/*
+ * Member definitions of 'BasicOrderBook'. 'OrderBook.cpp' instantiates 'OrderBook' from them,
+ * code using other traits includes this file instead of 'OrderBook.h'.
+ */
+#include "OrderBook.h"
+#include "CommandJournal.h"
+#include "PosixFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::PrintOrderBook()
+{
+    auto print_level = [this]( const Tick tick, const Level& orders )
+    {
+        printf( "%f: ", double( ToPrice(tick) ) );
+
+        for( Handle h = orders.head; h != OrderQueue::kNil; h = mPool[h].next )
+        {
+            mPool[h].print( mPool.GetCold(h).id );
+        }
+
+        printf("\n");
+        return true;
+    };
+
+    printf("orderbook ----------------------------------------- \n");
+    printf("SELL:\n");
+    mSellQueue.ForEach( print_level );
+
+    printf("BUY:\n");
+    mBuyQueue.ForEach( print_level );
+}
+
+
+inline double TicksPerUnit( const double tick_size, const double min_price, const double max_price )
+{
+    if( !(tick_size > 0.0) )
+    {
+        throw std::invalid_argument( "OrderBook: tick size must be positive" );
+    }
+
+    if( !(min_price <= max_price) )
+    {
+        throw std::invalid_argument( "OrderBook: min price must not be greater than max price" );
+    }
+
+    return 1.0 / tick_size;
+}
+
+
+template< class Traits >
+BasicOrderBook<Traits>::BasicOrderBook( const std::string& symbol, UniqueIDGenerator& id_gen, std::pmr::memory_resource* upstream )
+: mSymbol       { symbol },
+  mTicksPerUnit { 1.0 / kDefaultTickSize },
+  mOnTickOnly   { false },
+  mIdGen        { id_gen },
+  mArena        { upstream },
+  mSellQueue    { &mArena },
+  mBuyQueue     { &mArena }
+{
+
+}
+
+
+template< class Traits >
+BasicOrderBook<Traits>::BasicOrderBook( const std::string& symbol, UniqueIDGenerator& id_gen, const Price tick_size, const Price min_price, const Price max_price,
+                                        std::pmr::memory_resource* upstream ) requires std::is_floating_point_v<Price>
+: mSymbol       { symbol },
+  mTicksPerUnit { TicksPerUnit( tick_size, min_price, max_price ) },
+  mIdGen        { id_gen },
+  mArena        { upstream },
+  mSellQueue    { std::llround( min_price * mTicksPerUnit ), std::llround( max_price * mTicksPerUnit ), &mArena },
+  mBuyQueue     { std::llround( min_price * mTicksPerUnit ), std::llround( max_price * mTicksPerUnit ), &mArena }
+{
+
+}
+
+
+template< class Traits >
+BasicOrderBook<Traits>::BasicOrderBook( const std::string& symbol, UniqueIDGenerator& id_gen, const Price min_price, const Price max_price,
+                                        std::pmr::memory_resource* upstream ) requires std::is_integral_v<Price>
+: mSymbol       { symbol },
+  mTicksPerUnit { TicksPerUnit( 1.0, double(min_price), double(max_price) ) },
+  mIdGen        { id_gen },
+  mArena        { upstream },
+  mSellQueue    { Tick( min_price ), Tick( max_price ), &mArena },
+  mBuyQueue     { Tick( min_price ), Tick( max_price ), &mArena }
+{
+
+}
+
+
+template< class Traits >
+bool BasicOrderBook<Traits>::TryToTick( const Price price, Tick& tick ) const
+{
+    if constexpr( std::is_integral_v<Price> )
+    {
+        tick = Tick( price );
+    }
+    else
+    {
+        const double ticks = std::round( price * mTicksPerUnit );
+        if( !( std::fabs(ticks) < 0x1p62 ) ) { return false; }
+        tick = Tick( ticks );
+    }
+
+    // both sides share the same price band
+    return mBuyQueue.InRange( tick );
+}
+
+
+template< class Traits >
+typename BasicOrderBook<Traits>::Tick BasicOrderBook<Traits>::ToTick( const Price price ) const
+{
+    Tick tick;
+    if( !TryToTick( price, tick ) )
+    {
+        throw std::out_of_range( "OrderBook: price outside of price band for " + mSymbol );
+    }
+
+    if constexpr( std::is_floating_point_v<Price> )
+    {
+        // allow for the rounding error of converting a decimal price, but never snap to a tick
+        if( mOnTickOnly && std::fabs( double(price) * mTicksPerUnit - double(tick) ) > 1e-9 * std::max( 1.0, std::fabs( double(tick) ) ) )
+        {
+            throw std::invalid_argument( "OrderBook: price is not a multiple of the tick size for " + mSymbol );
+        }
+    }
+
+    return tick;
+}
+
+
+template< class Traits >
+typename BasicOrderBook<Traits>::Price BasicOrderBook<Traits>::ToPrice( const Tick tick ) const
+{
+    if constexpr( std::is_integral_v<Price> ) { return Price( tick ); }
+    else                                      { return Price( double(tick) / mTicksPerUnit ); }
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::Insert( const OrderId id, const Side side, const Price price, const Volume vol, const OwnerTag owner,
+                                     const TimeInForce tif )
+{
+    const auto timer = mStats.Time( StatsOp::INSERT );
+
+    const Tick price_tick = TimeInForce::MARKET == tif ? 0 : ToTick( price );
+
+    if( kAnyOwner == owner ) { throw std::invalid_argument( "OrderBook: 'kAnyOwner' is not an owner" ); }
+
+    if( TimeInForce::GTC == tif && mOrders.Size() >= kMaxRestingOrders )
+    {
+        throw std::length_error( "OrderBook: too many resting orders for 'Sequence' in " + mSymbol );
+    }
+
+    if( mJournal ) { mJournal->Append( Command{ Command::Type::INSERT, side, id, price, vol, owner, tif } ); }
+
+    if( TimeInForce::GTC != tif )
+    {
+        ExecuteImmediately( id, Side::SELL == side, price_tick, vol, tif );
+        PublishDeltas( );
+        return;
+    }
+
+    const size_t capacity = mPool.Capacity();
+    const Handle handle   = mPool.Allocate();
+    if( mPool.Capacity() != capacity ) { mStats.OnPoolGrowth(); }
+
+    const bool sell = Side::SELL == side;
+
+    Order& order         = mPool[handle];
+    order.priority       = NextPriority( sell );
+    order.price          = price_tick;
+    order.vol            = vol;
+    mPool.GetCold(handle) = OrderInfo{ id, owner };
+
+    mOrders.Insert( id, handle );
+
+    Level& level = WithSide( sell, [&]( auto& queue ) -> Level& { return queue.Get( order.price ); } );
+    if( level.empty() ) { mStats.OnLevelCreated(); }
+    level.Append( mPool, handle );
+    TouchLevel( sell, order.price );
+
+    if( !mInAuction ) { ExecuteOrders( ); }
+    PublishDeltas( );
+}
+
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::Amend( const OrderId id, const Price price, const Volume vol )
+{
+    const auto timer = mStats.Time( StatsOp::AMEND );
+
+    const Handle handle     = mOrders.Find( id );
+    if( OrderIndex::kNil == handle ) { return; }
+
+    Order&       order      = mPool[handle];
+    const Tick   price_tick = ToTick( price );
+
+    if( mJournal ) { mJournal->Append( Command{ Command::Type::AMEND, Side::BUY, id, price, vol } ); }
+
+    bool price_is_different = ( price_tick != order.price );
+    bool vol_increase       = ( vol        >  order.vol   );
+
+    const bool order_loses_time_priority = (vol_increase || price_is_different);
+    const bool sell                      = order.Sell();
+
+    WithSide( sell, [&]( auto& queue )
+    {
+        if( order_loses_time_priority )     // update internal id of order and move it to the back of the queue to give it lower priority
+        {
+            // remove order from queue
+            Level& old_level = *queue.Find( order.price );
+            old_level.Remove( mPool, handle );
+            TouchLevel( sell, order.price );
+
+            if( old_level.empty() )
+            {
+                queue.Remove( order.price );
+                mStats.OnLevelErased();
+            }
+
+            // update order
+            order.price    = price_tick;
+            order.vol      = vol;
+            order.priority = NextPriority( sell );
+
+            // lower the priority by appending to the back of the queue
+            Level& new_level = queue.Get(order.price);
+            if( new_level.empty() ) { mStats.OnLevelCreated(); }
+            new_level.Append( mPool, handle );
+            TouchLevel( sell, order.price );
+        }
+        else
+        {
+            // priority stays the same, only update volume
+            queue.Find( order.price )->Reduce( mPool, handle, order.vol - vol );
+            TouchLevel( sell, order.price );
+        }
+    } );
+
+    if( price_is_different && !mInAuction )
+    {
+        ExecuteOrders( );
+    }
+
+    PublishDeltas( );
+}
+
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::Pull( const OrderId id )
+{
+    const auto timer = mStats.Time( StatsOp::PULL );
+
+    if( const Handle handle = mOrders.Find( id ); OrderIndex::kNil != handle )
+    {
+        const Order& order  = mPool[handle];
+        const bool   sell   = order.Sell();
+
+        if( mJournal ) { mJournal->Append( Command{ Command::Type::PULL, Side::BUY, id, {}, {} } ); }
+
+        // delete order from sell/buy queue
+        WithSide( sell, [&]( auto& queue )
+        {
+            Level& level = *queue.Find( order.price );
+            level.Remove( mPool, handle );
+
+            // remove price level from sell/buy queue if no orders left at that price
+            if( level.empty() )
+            {
+                queue.Remove( order.price );
+                mStats.OnLevelErased();
+            }
+        } );
+        TouchLevel( sell, order.price );
+
+        mOrders.Erase(id);
+        mPool.Free(handle);
+
+        PublishDeltas( );
+    }
+}
+
+
+template< class Traits >
+size_t BasicOrderBook<Traits>::CancelOwner( const OwnerTag owner )
+{
+    if( kAnyOwner == owner ) { return CancelSide( Side::BUY ) + CancelSide( Side::SELL ); }
+
+    if( mJournal )
+    {
+        JournalPulls( false, std::numeric_limits<Tick>::min(), std::numeric_limits<Tick>::max(), owner );
+        JournalPulls( true,  std::numeric_limits<Tick>::min(), std::numeric_limits<Tick>::max(), owner );
+    }
+
+    size_t cancelled = 0;
+
+    for( const bool sell : { false, true } )
+    {
+        std::vector<Tick> emptied;
+
+        WithSide( sell, [&]( auto& queue )
+        {
+            queue.ForEach( [&]( const Tick tick, const Level& const_level )
+            {
+                Level& level = *queue.Find( tick );
+
+                for( Handle h = const_level.head; h != OrderQueue::kNil; )
+                {
+                    const Handle next = mPool[h].next;
+
+                    if( const OrderInfo& info = mPool.GetCold(h); owner == info.owner )
+                    {
+                        level.Remove( mPool, h );
+                        mOrders.Erase( info.id );
+                        mPool.Free( h );
+                        TouchLevel( sell, tick );
+                        ++cancelled;
+                    }
+
+                    h = next;
+                }
+
+                // levels can not be removed while iterating over them
+                if( level.empty() ) { emptied.push_back( tick ); }
+                return true;
+            } );
+
+            for( const Tick tick : emptied )
+            {
+                queue.Remove( tick );
+                mStats.OnLevelErased();
+            }
+        } );
+    }
+
+    PublishDeltas( );
+    return cancelled;
+}
+
+
+template< class Traits >
+size_t BasicOrderBook<Traits>::CancelSide( const Side side )
+{
+    return CancelLevels( Side::SELL == side, std::numeric_limits<Tick>::min(), std::numeric_limits<Tick>::max() );
+}
+
+
+template< class Traits >
+size_t BasicOrderBook<Traits>::CancelPriceRange( const Side side, const Price min_price, const Price max_price )
+{
+    // like 'TryToTick()', but without the price band check
+    auto to_tick = [this]( const Price price )
+    {
+        if constexpr( std::is_integral_v<Price> ) { return Tick( price ); }
+        else                                      { return Tick( std::clamp( std::round( price * mTicksPerUnit ), -0x1p62, 0x1p62 ) ); }
+    };
+
+    return CancelLevels( Side::SELL == side, to_tick( min_price ), to_tick( max_price ) );
+}
+
+
+template< class Traits >
+size_t BasicOrderBook<Traits>::CancelLevels( const bool sell, const Tick first, const Tick last )
+{
+    if( mJournal ) { JournalPulls( sell, first, last, kAnyOwner ); }
+
+    size_t cancelled = 0;
+
+    WithSide( sell, [&]( auto& queue )
+    {
+        queue.ForEach( [&]( const Tick tick, const Level& level )
+        {
+            if( sell ? tick < first : tick > last ) { return true;  }  // better than the range
+            if( sell ? tick > last  : tick < first ) { return false; } // worse than the range
+
+            // the whole level goes, so the orders are not unlinked one by one
+            for( Handle h = level.head; h != OrderQueue::kNil; )
+            {
+                const Handle next = mPool[h].next;
+
+                mOrders.Erase( mPool.GetCold(h).id );
+                mPool.Free( h );
+                ++cancelled;
+                h = next;
+            }
+
+            TouchLevel( sell, tick );
+            mStats.OnLevelErased();
+            return true;
+        } );
+
+        queue.RemoveRange( first, last );
+    } );
+
+    PublishDeltas( );
+    return cancelled;
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::JournalPulls( const bool sell, const Tick first, const Tick last, const OwnerTag owner )
+{
+    WithSide( sell, [&]( const auto& queue )
+    {
+        queue.ForEach( [&]( const Tick tick, const Level& level )
+        {
+            if( sell ? tick < first : tick > last ) { return true;  }  // better than the range
+            if( sell ? tick > last  : tick < first ) { return false; } // worse than the range
+
+            for( Handle h = level.head; h != OrderQueue::kNil; h = mPool[h].next )
+            {
+                if( const OrderInfo& info = mPool.GetCold(h); kAnyOwner == owner || owner == info.owner )
+                {
+                    mJournal->Append( Command{ Command::Type::PULL, Side::BUY, info.id, {}, {} } );
+                }
+            }
+            return true;
+        } );
+    } );
+}
+
+
+template< class Traits >
+size_t BasicOrderBook<Traits>::Reprice( const Side side, const std::int64_t ticks, const OwnerTag owner )
+{
+    const bool sell = Side::SELL == side;
+    if( 0 == ticks ) { return 0; }
+
+    std::pmr::vector<Handle> moved { &mArena };  // in price/time priority
+    std::pmr::vector<Tick>   from  { &mArena };  // price levels orders are moved away from, best first
+
+    WithSide( sell, [&]( auto& queue )
+    {
+        // check everything before changing anything
+        queue.ForEach( [&]( const Tick tick, const Level& level )
+        {
+            const size_t count = moved.size();
+
+            for( Handle h = level.head; h != OrderQueue::kNil; h = mPool[h].next )
+            {
+                if( kAnyOwner == owner || owner == mPool.GetCold(h).owner ) { moved.push_back( h ); }
+            }
+
+            if( moved.size() != count )
+            {
+                Tick moved_tick;
+                if( __builtin_add_overflow( tick, ticks, &moved_tick ) || !queue.InRange( moved_tick ) )
+                {
+                    throw std::out_of_range( "OrderBook: repriced order outside of price band for " + mSymbol );
+                }
+                from.push_back( tick );
+            }
+            return true;
+        } );
+
+        if( mJournal ) { mJournal->Append( Command{ Command::Type::REPRICE, side, {}, Price( ticks ), {}, owner } ); }
+
+        for( const Handle h : moved )
+        {
+            const Order& order = mPool[h];
+            Level&       level = *queue.Find( order.price );
+            level.Remove( mPool, h );
+
+            if( level.empty() )
+            {
+                queue.Remove( order.price );
+                mStats.OnLevelErased();
+            }
+        }
+
+        for( const Handle h : moved )
+        {
+            Order& order   = mPool[h];
+            order.price   += ticks;
+            order.priority = NextPriority( sell );
+
+            Level& level = queue.Get( order.price );
+            if( level.empty() ) { mStats.OnLevelCreated(); }
+            level.Append( mPool, h );
+        }
+    } );
+
+    // touch the old and new levels in one pass away from the spread, so 'TouchLevel()' keeps its fast path
+    std::pmr::vector<Tick> to( from.size(), &mArena );
+    std::transform( from.begin(), from.end(), to.begin(), [ticks]( const Tick tick ) { return tick + ticks; } );
+
+    std::pmr::vector<Tick> touched( 2 * from.size(), &mArena );
+    if( sell ) { std::merge( from.begin(), from.end(), to.begin(), to.end(), touched.begin(), std::less<Tick>() ); }
+    else       { std::merge( from.begin(), from.end(), to.begin(), to.end(), touched.begin(), std::greater<Tick>() ); }
+
+    for( const Tick tick : touched ) { TouchLevel( sell, tick ); }
+
+    if( !mInAuction ) { ExecuteOrders( ); }
+    PublishDeltas( );
+
+    return moved.size();
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::Apply( const Command& command )
+{
+    switch( command.type )
+    {
+        case Command::Type::INSERT:        Insert( command.id, command.side, command.price, command.vol, command.owner, command.tif ); break;
+        case Command::Type::AMEND:         Amend ( command.id,               command.price, command.vol );                break;
+        case Command::Type::PULL:          Pull  ( command.id );                                                          break;
+        case Command::Type::START_AUCTION: StartAuction();                                                                break;
+        case Command::Type::UNCROSS:       Uncross();                                                                     break;
+        case Command::Type::CANCEL_OWNER:  CancelOwner( command.owner );                                                  break;
+        case Command::Type::REPRICE:       Reprice( command.side, std::int64_t( command.price ), command.owner );         break;
+    }
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::ApplyBatch( const std::span<const Command> commands )
+{
+    constexpr size_t kPrefetchDistance = 4;  // Commands to look ahead.
+
+    const size_t inserts = size_t( std::count_if( commands.begin(), commands.end(),
+                                                  []( const Command& command ) { return Command::Type::INSERT == command.type; } ) );
+
+    // grow at least geometrically, so a stream of small batches does not reallocate every time
+    const size_t orders = mOrders.Size() + inserts;
+    if( orders > mPool.Capacity() ) { mPool.Reserve( std::max( orders, 2 * mPool.Capacity() ) ); }
+    mOrders.Reserve( orders );
+
+    for( size_t i = 0; i < commands.size(); ++i )
+    {
+        if( i + kPrefetchDistance < commands.size() )
+        {
+            const Command& upcoming = commands[ i + kPrefetchDistance ];
+            switch( upcoming.type )
+            {
+                case Command::Type::INSERT: PrefetchLevel( upcoming );         break;
+                case Command::Type::AMEND:
+                case Command::Type::PULL:   mOrders.Prefetch( upcoming.id );   break;
+                default:                                                       break;  // no order id to look up
+            }
+        }
+
+        Apply( commands[i] );
+    }
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::PrefetchLevel( const Command& command ) const
+{
+    if( Tick tick; TryToTick( command.price, tick ) )
+    {
+        WithSide( Side::SELL == command.side, [&]( const auto& queue ) { queue.Prefetch( tick ); } );
+    }
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::ExecuteOrders()
+{
+    const auto timer = mStats.Time( StatsOp::EXECUTE_ORDERS );
+
+    uint64_t fills  = 0;
+    uint64_t levels = 0;           // distinct passive price levels traded against
+    Tick     lastPassivePrice = 0;
+
+    while( !mBuyQueue.Empty() && !mSellQueue.Empty() )
+    {
+        const Tick buyPrice   = mBuyQueue.BestTick();
+        const Tick sellPrice  = mSellQueue.BestTick();
+
+        if( buyPrice < sellPrice ) { break; }
+
+        const Order& highestBuyOrder = mPool[ mBuyQueue.Best().head ];
+        const Order& lowestSellOrder = mPool[ mSellQueue.Best().head ];
+
+        // the trade happens at the price of the order which was in the book first
+        const Tick passivePrice = highestBuyOrder.priority < lowestSellOrder.priority ? buyPrice : sellPrice;
+
+        if( 0 == fills || passivePrice != lastPassivePrice ) { ++levels; }
+        lastPassivePrice = passivePrice;
+        ++fills;
+
+        MatchBestOrders( passivePrice, std::min( highestBuyOrder.vol, lowestSellOrder.vol ) );
+    }
+
+    mStats.OnSweep( fills, levels );
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::ExecuteImmediately( const OrderId id, const bool sell, const Tick limit, Volume vol, const TimeInForce tif )
+{
+    if( mInAuction || 0 == vol ) { return; }
+
+    WithSide( !sell, [&]( auto& passive )
+    {
+        auto crosses = [&]( const Tick tick )
+        {
+            return TimeInForce::MARKET == tif || ( sell ? tick >= limit : tick <= limit );
+        };
+
+        // a fill or kill order which can not be filled must not change anything
+        if( TimeInForce::FOK == tif )
+        {
+            Volume available = 0;
+            passive.ForEach( [&]( const Tick tick, const Level& level )
+            {
+                if( !crosses( tick ) ) { return false; }
+                available += level.vol;
+                return available < vol;
+            } );
+
+            if( available < vol ) { return; }
+        }
+
+        uint64_t fills  = 0;
+        uint64_t levels = 0;
+
+        while( 0 != vol && !passive.Empty() && crosses( passive.BestTick() ) )
+        {
+            const Tick tick  = passive.BestTick();
+            Level&     level = passive.Best();
+            TouchLevel( !sell, tick );
+            ++levels;
+
+            while( 0 != vol && !level.empty() )
+            {
+                const Handle  handle    = level.head;
+                Order&        order     = mPool[handle];
+                const OrderId passiveId = mPool.GetCold(handle).id;
+                const Volume  tradeVol  = std::min( vol, order.vol );
+
+                // the incoming order is always the aggressor
+                EmitTrade( ExecutedTrade{ ToPrice(tick), tradeVol, id, passiveId, mTradeIds.GenerateID() }, tick );
+
+                vol -= tradeVol;
+                ++fills;
+
+                if( tradeVol == order.vol )
+                {
+                    level.Remove( mPool, handle );
+                    mOrders.Erase( passiveId );
+                    mPool.Free( handle );
+                }
+                else
+                {
+                    level.Reduce( mPool, handle, tradeVol );
+                }
+            }
+
+            if( level.empty() )
+            {
+                passive.Remove( tick );
+                mStats.OnLevelErased();
+            }
+        }
+
+        mStats.OnSweep( fills, levels );
+    } );
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::EmitTrade( const ExecutedTrade& trade, const Tick tick )
+{
+    // hand trade to sink or store it for later
+    if( HasTradeSink() ) { mTradeSink( trade ); }
+    else                 { mExecutedTrades.push_back( trade ); }
+
+    uint64_t now = 0;
+    if( mTradeAnalytics.HasBars() )
+    {
+        now = mTradeClock ? mTradeClock()
+                          : uint64_t( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::system_clock::now().time_since_epoch() ).count() );
+    }
+
+    mTradeAnalytics.Record( tick, uint64_t( trade.volume ), now );
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::MatchBestOrders( const Tick price, const Volume tradeVol )
+{
+    const Tick buyPrice   = mBuyQueue.BestTick();
+    const Tick sellPrice  = mSellQueue.BestTick();
+
+    Level& highestBuyLevel  = mBuyQueue.Best();
+    Level& lowestSellLevel  = mSellQueue.Best();
+
+    const Handle buyHandle  = highestBuyLevel.head;
+    const Handle sellHandle = lowestSellLevel.head;
+
+    Order& highestBuyOrder  = mPool[buyHandle];
+    Order& lowestSellOrder  = mPool[sellHandle];
+
+    bool buySideIsPassive = highestBuyOrder.priority < lowestSellOrder.priority;
+
+    const OrderId buyId          = mPool.GetCold(buyHandle).id;
+    const OrderId sellId         = mPool.GetCold(sellHandle).id;
+    const OrderId passiveId      = buySideIsPassive ? buyId  : sellId;
+    const OrderId aggressiveId   = buySideIsPassive ? sellId : buyId;
+
+    EmitTrade( ExecutedTrade{ ToPrice(price), tradeVol, aggressiveId, passiveId, mTradeIds.GenerateID() }, price );
+
+    TouchLevel( false, buyPrice  );
+    TouchLevel( true,  sellPrice );
+
+    // remove orders left without volume, the others keep their place in the queue
+    if( tradeVol == highestBuyOrder.vol )
+    {
+        highestBuyLevel.Remove( mPool, buyHandle );
+        mOrders.Erase( buyId );
+        mPool.Free( buyHandle );
+
+        if( highestBuyLevel.empty() )
+        {
+            mBuyQueue.Remove( buyPrice );
+            mStats.OnLevelErased();
+        }
+    }
+    else
+    {
+        highestBuyLevel.Reduce( mPool, buyHandle, tradeVol );
+    }
+
+    if( tradeVol == lowestSellOrder.vol )
+    {
+        lowestSellLevel.Remove( mPool, sellHandle );
+        mOrders.Erase( sellId );
+        mPool.Free( sellHandle );
+
+        if( lowestSellLevel.empty() )
+        {
+            mSellQueue.Remove( sellPrice );
+            mStats.OnLevelErased();
+        }
+    }
+    else
+    {
+        lowestSellLevel.Reduce( mPool, sellHandle, tradeVol );
+    }
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::Level::Append( OrderPool<Order, OrderInfo>& pool, const OrderQueue::Handle handle )
+{
+    PushBack( pool, handle );
+    vol += pool[handle].vol;
+    ++count;
+
+    if constexpr( Traits::QueuePositions::kEnabled )
+    {
+        // slots of removed orders are only reclaimed by renumbering all orders of the level,
+        // which is done once they make up half of the slots to keep appends O(log n) amortized
+        if( positions.Slots() + 1 >= 2 * count + 16 )
+        {
+            positions.Clear();
+            for( OrderQueue::Handle h = head; h != kNil; h = pool[h].next )
+            {
+                pool.GetCold(h).slot = positions.Append( uint64_t( pool[h].vol ) );
+            }
+        }
+        else
+        {
+            pool.GetCold(handle).slot = positions.Append( uint64_t( pool[handle].vol ) );
+        }
+    }
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::Level::Remove( OrderPool<Order, OrderInfo>& pool, const OrderQueue::Handle handle )
+{
+    Unlink( pool, handle );
+    vol -= pool[handle].vol;
+    --count;
+
+    if constexpr( Traits::QueuePositions::kEnabled )
+    {
+        if( 0 == count ) { positions.Clear(); }
+        else             { positions.Remove( pool.GetCold(handle).slot, uint64_t( pool[handle].vol ) ); }
+    }
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::Level::Reduce( OrderPool<Order, OrderInfo>& pool, const OrderQueue::Handle handle, const Volume by )
+{
+    pool[handle].vol -= by;
+    vol -= by;
+
+    if constexpr( Traits::QueuePositions::kEnabled )
+    {
+        positions.Reduce( pool.GetCold(handle).slot, uint64_t( by ) );
+    }
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::ReserveOrders( const size_t max_orders )
+{
+    mPool.Reserve( max_orders );
+    mOrders.Reserve( max_orders );
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::Reserve( const size_t max_orders, const size_t max_levels, const size_t max_trades )
+{
+    ReserveOrders( max_orders );
+
+    mArena.Reserve( 2 * max_levels, mSellQueue.NodeSize() );  // both sides use the same kind of ladder
+    mTouched.reserve( 2 * max_levels );
+
+    // value initializing the trades writes every page of the list once, shrinking keeps the capacity
+    const size_t trades = mExecutedTrades.size();
+    if( max_trades > trades )
+    {
+        mExecutedTrades.resize( max_trades );
+        mExecutedTrades.resize( trades );
+    }
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::Reset()
+{
+    if( mDeltaSink )
+    {
+        auto publish_removed = [this]( const Side side )
+        {
+            return [this, side]( const Tick tick, const Level& )
+            {
+                mDeltaSink( LevelDelta{ ++mDeltaSeq, side, ToPrice(tick), 0, 0 } );
+                return true;
+            };
+        };
+
+        mBuyQueue.ForEach ( publish_removed( Side::BUY  ) );
+        mSellQueue.ForEach( publish_removed( Side::SELL ) );
+    }
+
+    // every container must have given its memory back before the arena is released
+    mOrders.Release();
+    decltype(mTouched)( &mArena ).swap( mTouched );
+    decltype(mRenumbered)( &mArena ).swap( mRenumbered );
+    mTouchedSides[0] = mTouchedSides[1] = TouchedSide{};
+    mPool.Release();
+    mSellQueue.Release();
+    mBuyQueue.Release();
+    mArena.release();
+
+    mSellQueue.Allocate();
+    mBuyQueue.Allocate();
+
+    mExecutedTrades.clear();
+    mTradeAnalytics.Clear();
+    mIntId     = 0;
+    mInAuction = false;
+
+    if( mDepthPublisher ) { PublishDepth(); }
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::StartAuction()
+{
+    if( mJournal ) { mJournal->Append( Command{ Command::Type::START_AUCTION, Side::BUY, {}, {}, {} } ); }
+
+    mInAuction = true;
+}
+
+
+template< class Traits >
+bool BasicOrderBook<Traits>::InAuction() const
+{
+    return mInAuction;
+}
+
+
+template< class Traits >
+typename BasicOrderBook<Traits>::AuctionResult BasicOrderBook<Traits>::GetIndicativeUncross() const
+{
+    Tick price;
+    return ComputeUncross( price );
+}
+
+
+template< class Traits >
+typename BasicOrderBook<Traits>::AuctionResult BasicOrderBook<Traits>::ComputeUncross( Tick& bestTick ) const
+{
+    AuctionResult result {};
+    bestTick = 0;
+    if( mBuyQueue.Empty() || mSellQueue.Empty() || mBuyQueue.BestTick() < mSellQueue.BestTick() ) { return result; }
+
+    const Tick highestBuy = mBuyQueue.BestTick();
+    const Tick lowestSell = mSellQueue.BestTick();
+
+    // only the levels inside the crossed range can trade, collect them lowest price first
+    struct Step { Tick tick; Volume vol; };
+    std::vector<Step> buys;
+    std::vector<Step> sells;
+    Volume buyVol = 0;  // volume bid at or above the current candidate price
+
+    mBuyQueue.ForEach( [&]( const Tick tick, const Level& level )
+    {
+        if( tick < lowestSell ) { return false; }
+        buys.push_back( Step{ tick, level.vol } );
+        buyVol += level.vol;
+        return true;
+    } );
+    std::reverse( buys.begin(), buys.end() );
+
+    mSellQueue.ForEach( [&]( const Tick tick, const Level& level )
+    {
+        if( tick > highestBuy ) { return false; }
+        sells.push_back( Step{ tick, level.vol } );
+        return true;
+    } );
+
+    // walk all level prices from low to high, bids drop out and offers come in as the price rises
+    Volume sellVol = 0;  // volume offered at or below the current candidate price
+    size_t b = 0;
+    size_t s = 0;
+
+    while( b < buys.size() || s < sells.size() )
+    {
+        const Tick price = s == sells.size() ? buys[b].tick
+                         : b == buys.size()  ? sells[s].tick
+                         : std::min( buys[b].tick, sells[s].tick );
+
+        while( s < sells.size() && sells[s].tick == price ) { sellVol += sells[s++].vol; }
+
+        const Volume volume  = std::min( buyVol, sellVol );
+        const Volume surplus = buyVol > sellVol ? buyVol - sellVol : sellVol - buyVol;
+
+        // most volume, then smallest surplus, then the highest price if buyers are left over
+        if( volume > result.volume ||
+            ( volume == result.volume && volume > 0 && ( surplus < result.surplus || ( surplus == result.surplus && buyVol > sellVol ) ) ) )
+        {
+            result.volume  = volume;
+            result.surplus = surplus;
+            bestTick       = price;
+        }
+
+        while( b < buys.size() && buys[b].tick == price ) { buyVol -= buys[b++].vol; }
+    }
+
+    result.price = ToPrice( bestTick );
+    return result;
+}
+
+
+template< class Traits >
+typename BasicOrderBook<Traits>::AuctionResult BasicOrderBook<Traits>::Uncross()
+{
+    if( mJournal ) { mJournal->Append( Command{ Command::Type::UNCROSS, Side::BUY, {}, {}, {} } ); }
+
+    mInAuction = false;
+
+    Tick price;
+    const AuctionResult result = ComputeUncross( price );
+
+    // both sides are filled in price/time priority, all at the clearing price
+    for( Volume remaining = result.volume; remaining > 0; )
+    {
+        const Volume tradeVol = std::min( { remaining, mPool[ mBuyQueue.Best().head ].vol, mPool[ mSellQueue.Best().head ].vol } );
+        MatchBestOrders( price, tradeVol );
+        remaining -= tradeVol;
+    }
+
+    PublishDeltas( );
+    return result;
+}
+
+
+template< class Traits >
+const std::vector< typename BasicOrderBook<Traits>::ExecutedTrade >& BasicOrderBook<Traits>::GetListOfTrades()
+{
+    return mExecutedTrades;
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::SetTradeSink( TradeSink sink )
+{
+    mTradeSink = std::move( sink );
+}
+
+
+template< class Traits >
+typename BasicOrderBook<Traits>::TradeSummary BasicOrderBook<Traits>::GetTradeSummary() const
+{
+    const TickBar& totals = mTradeAnalytics.Totals();
+    if( 0 == totals.trades ) { return TradeSummary{}; }
+
+    const double notional = mTradeAnalytics.Notional() / mTicksPerUnit;
+
+    return TradeSummary{ ToPrice( totals.open ), ToPrice( totals.high ), ToPrice( totals.low ), ToPrice( totals.close ),
+                         totals.volume, notional, notional / double( totals.volume ), totals.trades };
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::SetTradeBars( const uint64_t interval_ns, const size_t count, TradeClock clock )
+{
+    mTradeAnalytics.SetBars( interval_ns, count );
+    mTradeClock = std::move( clock );
+}
+
+
+template< class Traits >
+size_t BasicOrderBook<Traits>::GetTradeBars( std::span<TradeBar> out ) const
+{
+    const size_t count = std::min( out.size(), mTradeAnalytics.BarCount() );
+    const size_t first = mTradeAnalytics.BarCount() - count;
+
+    for( size_t i = 0; i < count; ++i )
+    {
+        const TickBar& bar = mTradeAnalytics.Bar( first + i );
+        out[i] = TradeBar{ bar.start, ToPrice( bar.open ), ToPrice( bar.high ), ToPrice( bar.low ), ToPrice( bar.close ), bar.volume, bar.trades };
+    }
+
+    return count;
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::SetJournal( CommandJournal* journal )
+{
+    mJournal = journal;
+}
+
+
+template< class Traits >
+CommandJournal* BasicOrderBook<Traits>::GetJournal() const
+{
+    return mJournal;
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::SetTradeIDBlockSize( const size_t block_size )
+{
+    mTradeIds.SetBlockSize( block_size );
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::SetDeltaSink( DeltaSink sink )
+{
+    mDeltaSink = std::move( sink );
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::SetDepthPublisher( DepthPublisher* publisher )
+{
+    mDepthPublisher = publisher;
+    mDepth.resize( publisher ? publisher->MaxLevels() : 0 );
+
+    if( mDepthPublisher ) { PublishDepth(); }
+}
+
+
+template< class Traits >
+OrderBookStatsSnapshot BasicOrderBook<Traits>::GetStats() const
+{
+    return mStats.Snapshot();
+}
+
+
+template< class Traits >
+typename BasicOrderBook<Traits>::MemoryUsage BasicOrderBook<Traits>::GetMemoryUsage() const
+{
+    MemoryUsage usage;
+    usage.orders         = mPool.MemoryUsage();
+    usage.order_index    = mOrders.MemoryUsage();
+    usage.price_levels   = mSellQueue.MemoryUsage() + mBuyQueue.MemoryUsage();
+    usage.touched_levels = mTouched.capacity() * sizeof(TouchedLevel);
+    usage.arena          = mArena.GetChunkBytes() + mArena.GetLargeBlockBytes();
+    usage.trades         = mExecutedTrades.capacity() * sizeof(ExecutedTrade);
+    usage.book           = sizeof(*this);
+    return usage;
+}
+
+
+template< class Traits >
+typename BasicOrderBook<Traits>::Sequence BasicOrderBook<Traits>::NextPriority( const bool sell )
+{
+    if( mIntId > kMaxIntId ) { RenumberPriorities(); }
+
+    return Sequence( ( Sequence( mIntId++ ) << 1 ) | Sequence( sell ) );
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::RenumberPriorities()
+{
+    std::pmr::vector<Handle>& handles = mRenumbered;
+    handles.clear();
+    handles.reserve( mOrders.Size() );
+
+    auto collect = [&]( const Tick, const Level& level )
+    {
+        for( Handle h = level.head; h != OrderQueue::kNil; h = mPool[h].next ) { handles.push_back( h ); }
+        return true;
+    };
+
+    mSellQueue.ForEach( collect );
+    mBuyQueue.ForEach( collect );
+
+    std::sort( handles.begin(), handles.end(), [&]( const Handle a, const Handle b ) { return mPool[a].priority < mPool[b].priority; } );
+
+    mIntId = 0;
+    for( const Handle h : handles )
+    {
+        Order& order   = mPool[h];
+        order.priority = Sequence( ( Sequence( mIntId++ ) << 1 ) | ( order.priority & 1 ) );
+    }
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::TouchLevel( const bool sell, const Tick tick )
+{
+    if( !mDeltaSink && !mDepthPublisher ) { return; }
+
+    // Most operations move through the levels of a side away from the spread (sweeps, mass cancels),
+    // so a level touched again is the last one touched on its side. Once a side is touched out of
+    // that order, e.g. by matching after a reprice, every level touched on it is searched.
+    TouchedSide& side = mTouchedSides[sell];
+    if( side.any )
+    {
+        if( side.last == tick ) { return; }
+
+        if( !side.in_order || ( sell ? tick < side.last : tick > side.last ) )
+        {
+            side.in_order = false;
+            for( const TouchedLevel& touched : mTouched )
+            {
+                if( touched.sell == sell && touched.tick == tick ) { return; }
+            }
+        }
+    }
+
+    side.last = tick;
+    side.any  = true;
+    mTouched.push_back( { sell, tick } );
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::PublishDeltas()
+{
+    if( mTouched.empty() ) { return; }
+
+    if( mDeltaSink )
+    {
+        for( const TouchedLevel& touched : mTouched )
+        {
+            LevelDelta delta { ++mDeltaSeq, touched.sell ? Side::SELL : Side::BUY, ToPrice(touched.tick), 0, 0 };
+
+            if( const Level* level = WithSide( touched.sell, [&]( const auto& queue ) { return queue.Find( touched.tick ); } ); level )
+            {
+                delta.vol   = level->vol;
+                delta.count = level->count;
+            }
+
+            mDeltaSink( delta );
+        }
+    }
+
+    if( mDepthPublisher ) { PublishDepth(); }
+
+    mTouched.clear();
+    mTouchedSides[0] = mTouchedSides[1] = TouchedSide{};
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::PublishDepth()
+{
+    const size_t count = GetDepth( mDepth.size(), mDepth );
+    mDepthPublisher->Publish( std::span<const PriceLevel>( mDepth.data(), count ) );
+}
+
+
+template< class Traits >
+std::vector< typename BasicOrderBook<Traits>::PriceLevel > BasicOrderBook<Traits>::GetPriceLevels()
+{
+    const auto timer = mStats.Time( StatsOp::GET_PRICE_LEVELS );
+
+    std::vector< PriceLevel > result;
+
+    mBuyQueue.ForEach( [&]( const Tick tick, const Level& level )
+    {
+        result.push_back( PriceLevel{ ToPrice(tick), level.vol } );
+        return true;
+    } );
+
+    size_t index = 0;
+    mSellQueue.ForEach( [&]( const Tick tick, const Level& level )
+    {
+        if( index == result.size() )
+        {
+            result.emplace_back();
+        }
+
+        result[index].sell_price = ToPrice(tick);
+        result[index].sell_vol   = level.vol;
+
+        ++index;
+        return true;
+    } );
+
+    return result;
+}
+
+
+template< class Traits >
+typename BasicOrderBook<Traits>::PriceLevel BasicOrderBook<Traits>::GetTopOfBook() const
+{
+    PriceLevel top;
+    GetDepth( 1, std::span<PriceLevel>( &top, 1 ) );
+    return top;
+}
+
+
+template< class Traits >
+size_t BasicOrderBook<Traits>::GetDepth( const size_t n, std::span<PriceLevel> out ) const
+{
+    const size_t max_levels = std::min( n, out.size() );
+    size_t buy_levels  = 0;
+    size_t sell_levels = 0;
+
+    if( 0 == max_levels ) { return 0; }
+
+    mBuyQueue.ForEach( [&]( const Tick tick, const Level& level )
+    {
+        out[buy_levels] = PriceLevel{ ToPrice(tick), level.vol };
+        return ++buy_levels < max_levels;
+    } );
+
+    mSellQueue.ForEach( [&]( const Tick tick, const Level& level )
+    {
+        if( sell_levels >= buy_levels )
+        {
+            out[sell_levels] = PriceLevel{};
+        }
+
+        out[sell_levels].sell_price = ToPrice(tick);
+        out[sell_levels].sell_vol   = level.vol;
+        return ++sell_levels < max_levels;
+    } );
+
+    return std::max( buy_levels, sell_levels );
+}
+
+
+template< class Traits >
+bool BasicOrderBook<Traits>::GetQueuePosition( const OrderId id, QueuePosition& position ) const
+{
+    const Handle handle = mOrders.Find( id );
+    if( OrderIndex::kNil == handle ) { return false; }
+
+    const Order& order = mPool[handle];
+    const Level& level = *WithSide( order.Sell(), [&]( const auto& queue ) { return queue.Find( order.price ); } );
+
+    QueueAhead ahead;
+    if constexpr( Traits::QueuePositions::kEnabled )
+    {
+        ahead = level.positions.Ahead( mPool.GetCold(handle).slot );
+    }
+    else
+    {
+        for( Handle h = level.head; h != handle; h = mPool[h].next )
+        {
+            ahead.volume += mPool[h].vol;
+            ahead.orders += 1;
+        }
+    }
+
+    position = QueuePosition{ order.Sell() ? Side::SELL : Side::BUY, ToPrice( order.price ), order.vol,
+                              Volume( ahead.volume ), size_t( ahead.orders ) };
+    return true;
+}
+
+
+template< class Traits >
+typename BasicOrderBook<Traits>::LevelOrders BasicOrderBook<Traits>::GetLevelOrders( const Side side, const Price price ) const
+{
+    Tick tick;
+    if( !TryToTick( price, tick ) ) { return LevelOrders{}; }
+
+    const Level* level = WithSide( Side::SELL == side, [&]( const auto& queue ) { return queue.Find( tick ); } );
+    if( nullptr == level ) { return LevelOrders{}; }
+
+    return MakeLevelOrders( side, tick, *level );
+}
+
+
+namespace snapshot_format
+{
+    inline constexpr char     kSnapshotMagic[8]  { 'O', 'B', 'S', 'N', 'A', 'P', 'S', 'H' };
+    inline constexpr uint32_t kSnapshotVersion   { 3 };
+    inline constexpr uint32_t kSnapshotInAuction { 1 };  // Flag of an order book between 'StartAuction()' and 'Uncross()'.
+
+
+    /**
+     * @brief Start of a snapshot file.
+     */
+    struct SnapshotHeader
+    {
+        char     magic[8];        // 'kSnapshotMagic'
+        uint32_t version;         // 'kSnapshotVersion'
+        uint32_t record_size;     // 'sizeof(SnapshotOrder)'
+        double   ticks_per_unit;  // Ticks per whole price unit of the order book.
+        uint64_t int_id;          // Next internal order id, i.e. 'OrderBook::mIntId'.
+        uint64_t next_trade_id;   // Next ID of the 'UniqueIDGenerator'.
+        uint64_t delta_seq;       // Sequence number of the last published price level delta.
+        uint64_t buy_orders;      // Number of buy orders following the header.
+        uint64_t sell_orders;     // Number of sell orders following the buy orders.
+        uint32_t flags;           // 'kSnapshotInAuction' or 0.
+        uint32_t reserved;        // Always 0.
+    };
+
+
+    /**
+     * @brief A resting order. Orders are stored best price first, in time priority within a price.
+     */
+    struct SnapshotOrder
+    {
+        uint64_t id;
+        uint64_t int_id;
+        int64_t  price;        // In ticks.
+        uint64_t vol;
+        uint32_t owner;
+        uint32_t reserved;     // Always 0.
+    };
+
+    static_assert( sizeof(SnapshotHeader) == 72 && sizeof(SnapshotOrder) == 40, "snapshot records must have a fixed size" );
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::SaveSnapshot( const std::string& path ) const
+{
+    using namespace snapshot_format;
+    constexpr size_t kRecordsPerWrite = 4096;
+
+    SnapshotHeader header {};
+    std::memcpy( header.magic, kSnapshotMagic, sizeof(kSnapshotMagic) );
+    header.version        = kSnapshotVersion;
+    header.record_size    = sizeof(SnapshotOrder);
+    header.ticks_per_unit = mTicksPerUnit;
+    header.int_id         = mIntId;
+    header.next_trade_id  = mIdGen.PeekNextID();
+    header.delta_seq      = mDeltaSeq;
+    header.flags          = mInAuction ? kSnapshotInAuction : 0;
+
+    auto count_orders = []( const Tick, const Level& level, uint64_t& orders ) { orders += level.count; return true; };
+    mBuyQueue.ForEach ( [&]( const Tick tick, const Level& level ) { return count_orders( tick, level, header.buy_orders  ); } );
+    mSellQueue.ForEach( [&]( const Tick tick, const Level& level ) { return count_orders( tick, level, header.sell_orders ); } );
+
+    const std::string tmp_path = path + ".tmp";
+    const int fd = ::open( tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    if( fd < 0 ) { ThrowSystemError( "OrderBook: cannot open " + tmp_path ); }
+
+    try
+    {
+        WriteAll( fd, &header, sizeof(header) );
+
+        std::vector<SnapshotOrder> buffer;
+        buffer.reserve( kRecordsPerWrite );
+
+        auto write_level = [&]( const Tick tick, const Level& level )
+        {
+            for( Handle h = level.head; h != OrderQueue::kNil; h = mPool[h].next )
+            {
+                const Order& order = mPool[h];
+                buffer.push_back( SnapshotOrder{ uint64_t( mPool.GetCold(h).id ), order.IntId(), tick, uint64_t(order.vol), mPool.GetCold(h).owner, 0 } );
+
+                if( buffer.size() == kRecordsPerWrite )
+                {
+                    WriteAll( fd, buffer.data(), buffer.size() * sizeof(SnapshotOrder) );
+                    buffer.clear();
+                }
+            }
+            return true;
+        };
+
+        mBuyQueue.ForEach( write_level );
+        mSellQueue.ForEach( write_level );
+        WriteAll( fd, buffer.data(), buffer.size() * sizeof(SnapshotOrder) );
+
+        if( ::fdatasync( fd ) < 0 ) { ThrowSystemError( "OrderBook: cannot sync " + tmp_path ); }
+    }
+    catch( ... )
+    {
+        ::close( fd );
+        ::unlink( tmp_path.c_str() );
+        throw;
+    }
+
+    ::close( fd );
+
+    if( ::rename( tmp_path.c_str(), path.c_str() ) < 0 )
+    {
+        ThrowSystemError( "OrderBook: cannot rename " + tmp_path );
+    }
+}
+
+
+template< class Traits >
+void BasicOrderBook<Traits>::LoadSnapshot( const std::string& path )
+{
+    using namespace snapshot_format;
+    if( !mOrders.Empty() )
+    {
+        throw std::logic_error( "OrderBook: a snapshot can only be loaded into an empty order book" );
+    }
+
+    const MappedFile file( path );
+
+    const auto* header = reinterpret_cast<const SnapshotHeader*>( file.Data() );
+    if( file.Size() < sizeof(SnapshotHeader) || 0 != std::memcmp( header->magic, kSnapshotMagic, sizeof(kSnapshotMagic) ) ||
+        kSnapshotVersion != header->version || sizeof(SnapshotOrder) != header->record_size ||
+        0 != ( header->flags & ~kSnapshotInAuction ) ||
+        0 != ( file.Size() - sizeof(SnapshotHeader) ) % sizeof(SnapshotOrder) ||
+        header->buy_orders > ( file.Size() - sizeof(SnapshotHeader) ) / sizeof(SnapshotOrder) ||
+        header->sell_orders != ( file.Size() - sizeof(SnapshotHeader) ) / sizeof(SnapshotOrder) - header->buy_orders )
+    {
+        throw std::invalid_argument( "OrderBook: not a valid snapshot file " + path );
+    }
+
+    if( header->ticks_per_unit != mTicksPerUnit )
+    {
+        throw std::invalid_argument( "OrderBook: snapshot was written by an order book with a different tick size" );
+    }
+
+    const auto*  orders = reinterpret_cast<const SnapshotOrder*>( file.Data() + sizeof(SnapshotHeader) );
+    const size_t total  = header->buy_orders + header->sell_orders;
+
+    if( total > kMaxRestingOrders )
+    {
+        throw std::length_error( "OrderBook: snapshot contains more resting orders than 'Sequence' allows" );
+    }
+
+    // check everything before touching the order book so a bad snapshot leaves it empty
+    for( size_t i = 0; i < total; ++i )
+    {
+        if( !mBuyQueue.InRange( orders[i].price ) )
+        {
+            throw std::out_of_range( "OrderBook: snapshot contains a price outside of the price band" );
+        }
+
+        if( orders[i].int_id > kMaxIntId )
+        {
+            throw std::out_of_range( "OrderBook: snapshot contains a time priority which does not fit 'Sequence'" );
+        }
+
+        if( 0 == orders[i].vol || orders[i].vol > uint64_t( std::numeric_limits<Volume>::max() ) )
+        {
+            throw std::out_of_range( "OrderBook: snapshot contains an order volume which is 0 or does not fit 'Volume'" );
+        }
+
+        if( orders[i].id > uint64_t( std::numeric_limits<OrderId>::max() ) )
+        {
+            throw std::out_of_range( "OrderBook: snapshot contains an order id which does not fit 'OrderId'" );
+        }
+
+        if( orders[i].int_id >= header->int_id )
+        {
+            throw std::invalid_argument( "OrderBook: snapshot contains a time priority the order book would hand out again" );
+        }
+    }
+
+    // orders are appended to their level in file order, which must be the order of their time priority
+    std::vector<size_t> by_level( total );
+    std::iota( by_level.begin(), by_level.end(), size_t( 0 ) );
+    std::stable_sort( by_level.begin(), by_level.end(), [&]( const size_t a, const size_t b )
+    {
+        return std::pair( a >= header->buy_orders, orders[a].price ) < std::pair( b >= header->buy_orders, orders[b].price );
+    } );
+
+    for( size_t i = 1; i < total; ++i )
+    {
+        const size_t prev = by_level[i - 1];
+        const size_t next = by_level[i];
+        if( ( prev >= header->buy_orders ) == ( next >= header->buy_orders ) && orders[prev].price == orders[next].price &&
+            orders[prev].int_id >= orders[next].int_id )
+        {
+            throw std::invalid_argument( "OrderBook: snapshot contains a price level which is not in time priority" );
+        }
+    }
+
+    std::vector<uint64_t> ids( total );
+    std::transform( orders, orders + total, ids.begin(), []( const SnapshotOrder& record ) { return record.id; } );
+    std::sort( ids.begin(), ids.end() );
+    if( std::adjacent_find( ids.begin(), ids.end() ) != ids.end() )
+    {
+        throw std::invalid_argument( "OrderBook: snapshot contains an order id more than once" );
+    }
+
+    mPool.Reserve( total );
+    mOrders.Reserve( total );
+
+    for( size_t i = 0; i < total; ++i )
+    {
+        const SnapshotOrder& record = orders[i];
+        const Handle         handle = mPool.Allocate();
+
+        const bool sell = i >= header->buy_orders;
+
+        Order& order          = mPool[handle];
+        order.priority        = Sequence( ( Sequence( record.int_id ) << 1 ) | Sequence( sell ) );
+        order.price           = record.price;
+        order.vol             = Volume( record.vol );
+        mPool.GetCold(handle) = OrderInfo{ OrderId( record.id ), OwnerTag( record.owner ) };
+
+        mOrders.Insert( OrderId( record.id ), handle );
+
+        Level& level = WithSide( sell, [&]( auto& queue ) -> Level& { return queue.Get( order.price ); } );
+        level.Append( mPool, handle );
+    }
+
+    mIntId     = size_t( header->int_id );
+    mDeltaSeq  = header->delta_seq;
+    mInAuction = 0 != ( header->flags & kSnapshotInAuction );
+    mIdGen.AdvanceTo( header->next_trade_id );
+    mTradeIds.Discard();
+
+    if( mDepthPublisher ) { PublishDepth(); }
+}
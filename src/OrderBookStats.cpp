@@ -0,0 +1,54 @@
+#include "OrderBookStats.h"
+
+#include <thread>
+
+
+double CyclesPerNanosecond()
+{
+    static const double cycles_per_ns = []
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const auto     start_time   = Clock::now();
+        const uint64_t start_cycles = ReadCycleCounter();
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+
+        const uint64_t cycles = ReadCycleCounter() - start_cycles;
+        const auto     ns     = std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - start_time ).count();
+
+        return ns > 0 && cycles > 0 ? double(cycles) / double(ns) : 1.0;
+    }();
+
+    return cycles_per_ns;
+}
+
+
+OrderBookStatsSnapshot OrderBookStats::Snapshot() const
+{
+    OrderBookStatsSnapshot snapshot;
+    const double cycles_per_ns = CyclesPerNanosecond();
+
+    for( size_t op = 0; op < mLatency.size(); ++op )
+    {
+        const Histogram& histogram = mLatency[op];
+        auto&            latency   = snapshot.latency[op];
+
+        latency.count   = histogram.Count();
+        latency.p50_ns  = double( histogram.Percentile( 50.0 ) ) / cycles_per_ns;
+        latency.p99_ns  = double( histogram.Percentile( 99.0 ) ) / cycles_per_ns;
+        latency.p999_ns = double( histogram.Percentile( 99.9 ) ) / cycles_per_ns;
+        latency.max_ns  = double( histogram.Max() )              / cycles_per_ns;
+    }
+
+    snapshot.aggressive_orders       = mFillsPerAggressor.Count();
+    snapshot.fills                   = mFillsPerAggressor.Sum();
+    snapshot.max_fills_per_aggressor = mFillsPerAggressor.Max();
+    snapshot.levels_crossed          = mLevelsPerSweep.Sum();
+    snapshot.max_levels_per_sweep    = mLevelsPerSweep.Max();
+    snapshot.level_creations         = mLevelCreations.load( std::memory_order_relaxed );
+    snapshot.level_erasures          = mLevelErasures.load( std::memory_order_relaxed );
+    snapshot.pool_growths            = mPoolGrowths.load( std::memory_order_relaxed );
+
+    return snapshot;
+}
@@ -0,0 +1,256 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Reads a cheap, monotonically increasing cycle counter (TSC on x86, steady clock ns elsewhere).
+ */
+inline uint64_t ReadCycleCounter()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return uint64_t( std::chrono::steady_clock::now().time_since_epoch().count() );
+#endif
+}
+
+
+/**
+ * @brief Returns the number of cycle counter ticks per nanosecond. Measured once, on first use.
+ */
+double CyclesPerNanosecond();
+
+
+/**
+ * @brief Log-linear histogram in the style of HDR histograms: values are grouped in power of two
+ *        ranges, each split in 'kSubBuckets' linear buckets, so the relative error is at most
+ *        1/kSubBuckets. Meant for a single writer; any thread may read it at any time without
+ *        stopping the writer, at the cost of seeing a slightly inconsistent set of buckets.
+ */
+class Histogram
+{
+public:
+
+    static constexpr unsigned kSubBucketBits = 4;
+    static constexpr unsigned kSubBuckets    = 1u << kSubBucketBits;
+    static constexpr unsigned kMaxValueBits  = 48;  // Larger values are recorded in the last bucket.
+    static constexpr size_t   kBuckets       = kSubBuckets * ( kMaxValueBits - kSubBucketBits + 1 );
+
+
+    /**
+     * @brief Adds 'value' to the histogram. Writer thread only.
+     */
+    void Record( const uint64_t value )
+    {
+        Increment( mBuckets[ BucketIndex( value ) ] );
+        Increment( mCount );
+        mSum.store( mSum.load( std::memory_order_relaxed ) + value, std::memory_order_relaxed );
+        if( value > mMax.load( std::memory_order_relaxed ) ) { mMax.store( value, std::memory_order_relaxed ); }
+    }
+
+
+    uint64_t Count() const { return mCount.load( std::memory_order_relaxed ); }
+    uint64_t Sum()   const { return mSum.load( std::memory_order_relaxed ); }
+    uint64_t Max()   const { return mMax.load( std::memory_order_relaxed ); }
+
+
+    /**
+     * @brief Returns the upper bound of the bucket containing the value at 'percentile' (0-100).
+     */
+    uint64_t Percentile( const double percentile ) const
+    {
+        const uint64_t count = Count();
+        if( 0 == count ) { return 0; }
+
+        const uint64_t target = std::max<uint64_t>( 1, uint64_t( percentile / 100.0 * double(count) + 0.5 ) );
+        uint64_t seen = 0;
+
+        for( size_t i = 0; i < kBuckets; ++i )
+        {
+            seen += mBuckets[i].load( std::memory_order_relaxed );
+            if( seen >= target ) { return std::min( BucketUpperBound( i ), Max() ); }
+        }
+
+        return Max();
+    }
+
+
+private:
+
+    static void Increment( std::atomic<uint64_t>& counter )
+    {
+        // single writer, so a plain load and store is enough and avoids a locked instruction
+        counter.store( counter.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    }
+
+
+    static size_t BucketIndex( const uint64_t value )
+    {
+        if( value < kSubBuckets ) { return size_t(value); }
+
+        const unsigned magnitude = unsigned( std::bit_width( value ) ) - 1;  // >= kSubBucketBits
+        if( magnitude >= kMaxValueBits ) { return kBuckets - 1; }
+
+        const unsigned shift = magnitude - kSubBucketBits;
+        return size_t( kSubBuckets * ( shift + 1 ) + ( ( value >> shift ) & ( kSubBuckets - 1 ) ) );
+    }
+
+
+    static uint64_t BucketUpperBound( const size_t index )
+    {
+        if( index < kSubBuckets )  { return index; }
+        if( index == kBuckets - 1 ) { return UINT64_MAX; }  // also holds everything beyond 'kMaxValueBits'
+
+        const unsigned shift = unsigned( index / kSubBuckets ) - 1;
+        const uint64_t sub   = index % kSubBuckets;
+        return ( ( kSubBuckets + sub + 1 ) << shift ) - 1;
+    }
+
+
+    std::array< std::atomic<uint64_t>, kBuckets > mBuckets {};
+    std::atomic<uint64_t> mCount { 0 };
+    std::atomic<uint64_t> mSum   { 0 };
+    std::atomic<uint64_t> mMax   { 0 };
+};
+
+
+/**
+ * @brief Operations of an order book whose latency is measured.
+ */
+enum class StatsOp
+{
+    INSERT = 0,
+    AMEND,
+    PULL,
+    GET_PRICE_LEVELS,
+    EXECUTE_ORDERS,
+    COUNT
+};
+
+
+/**
+ * @brief Plain copy of the statistics of an order book, see 'OrderBook::GetStats()'.
+ */
+struct OrderBookStatsSnapshot
+{
+    struct Latency
+    {
+        uint64_t count   = 0;
+        double   p50_ns  = 0;
+        double   p99_ns  = 0;
+        double   p999_ns = 0;
+        double   max_ns  = 0;
+    };
+
+    std::array< Latency, size_t(StatsOp::COUNT) > latency {};  // Indexed by 'StatsOp'.
+
+    uint64_t aggressive_orders       = 0;  // Operations which resulted in at least one fill.
+    uint64_t fills                   = 0;
+    uint64_t max_fills_per_aggressor = 0;
+    uint64_t levels_crossed          = 0;  // Passive price levels traded against, summed over all sweeps.
+    uint64_t max_levels_per_sweep    = 0;
+    uint64_t level_creations         = 0;
+    uint64_t level_erasures          = 0;
+    uint64_t pool_growths            = 0;  // Times the order slab had to reallocate.
+};
+
+
+/**
+ * @brief Collects latency histograms and event counters of one order book. Updated by the thread
+ *        running the order book, readable from any thread through 'Snapshot()'.
+ */
+class OrderBookStats
+{
+public:
+
+    /**
+     * @brief Records the latency of 'op' from construction until destruction.
+     */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer( OrderBookStats& stats, const StatsOp op ) : mStats { stats }, mOp { op }, mStart { ReadCycleCounter() } {}
+        ~ScopedTimer() { mStats.mLatency[ size_t(mOp) ].Record( ReadCycleCounter() - mStart ); }
+
+        ScopedTimer( const ScopedTimer& ) = delete;
+        ScopedTimer& operator=( const ScopedTimer& ) = delete;
+
+    private:
+        OrderBookStats& mStats;
+        const StatsOp   mOp;
+        const uint64_t  mStart;
+    };
+
+    ScopedTimer Time( const StatsOp op ) { return ScopedTimer( *this, op ); }
+
+    void OnSweep( const uint64_t fills, const uint64_t levels )
+    {
+        if( 0 == fills ) { return; }
+        mFillsPerAggressor.Record( fills );
+        mLevelsPerSweep.Record( levels );
+    }
+
+    void OnLevelCreated() { Increment( mLevelCreations ); }
+    void OnLevelErased()  { Increment( mLevelErasures  ); }
+    void OnPoolGrowth()   { Increment( mPoolGrowths    ); }
+
+    /**
+     * @brief Returns a copy of the current statistics. May be called from any thread.
+     */
+    OrderBookStatsSnapshot Snapshot() const;
+
+private:
+
+    static void Increment( std::atomic<uint64_t>& counter )
+    {
+        counter.store( counter.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    }
+
+    std::array< Histogram, size_t(StatsOp::COUNT) > mLatency;  // In cycles, indexed by 'StatsOp'.
+    Histogram mFillsPerAggressor;
+    Histogram mLevelsPerSweep;
+    std::atomic<uint64_t> mLevelCreations { 0 };
+    std::atomic<uint64_t> mLevelErasures  { 0 };
+    std::atomic<uint64_t> mPoolGrowths    { 0 };
+};
+
+
+/**
+ * @brief Drop in replacement for 'OrderBookStats' which records nothing and compiles away.
+ */
+class NoOrderBookStats
+{
+public:
+
+    struct ScopedTimer
+    {
+        ~ScopedTimer() {}  // user provided, so an unused timer does not trigger warnings
+    };
+
+    ScopedTimer Time( const StatsOp ) { return {}; }
+    void OnSweep( const uint64_t, const uint64_t ) {}
+    void OnLevelCreated() {}
+    void OnLevelErased()  {}
+    void OnPoolGrowth()   {}
+
+    OrderBookStatsSnapshot Snapshot() const { return {}; }
+};
+
+
+/**
+ * @brief Statistics policy of 'OrderBook', chosen by 'ORDERBOOK_ENABLE_STATS'.
+ */
+#ifdef ORDERBOOK_ENABLE_STATS
+using DefaultOrderBookStats = OrderBookStats;
+#else
+using DefaultOrderBookStats = NoOrderBookStats;
+#endif
@@ -0,0 +1,472 @@
+#include "OrderFlowReplayer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "PosixFile.h"
+
+
+namespace
+{
+    constexpr size_t kChunkBytes = size_t(4) << 20;  // Bytes of a capture parsed by one thread at a time.
+
+
+    /**
+     * @brief A parsed message. 'symbol' points into the mapped capture file.
+     */
+    struct Message
+    {
+        std::string_view   symbol;
+        OrderBook::Command command;
+    };
+
+
+    /**
+     * @brief Messages of one chunk, split by the worker owning their symbol. Reused for every
+     *        chunk, so parsing only allocates until the vectors have grown to a chunk's worth.
+     */
+    using ParsedChunk = std::vector< std::vector<Message> >;
+
+
+    std::string_view Trim( std::string_view text )
+    {
+        while( !text.empty() && ( ' ' == text.front() || '\t' == text.front() ) )                          { text.remove_prefix( 1 ); }
+        while( !text.empty() && ( ' ' == text.back()  || '\t' == text.back() || '\r' == text.back() ) )   { text.remove_suffix( 1 ); }
+        return text;
+    }
+
+
+    template< class T >
+    bool ParseNumber( const std::string_view text, T& value )
+    {
+        const auto [end, error] = std::from_chars( text.data(), text.data() + text.size(), value );
+        return std::errc() == error && end == text.data() + text.size();
+    }
+
+
+    /**
+     * @brief Parses one line of a text capture. Returns false if the line is malformed.
+     */
+    bool ParseLine( const std::string_view line, Message& message )
+    {
+        constexpr size_t kColumns = 6;
+
+        std::string_view columns[kColumns];
+        size_t           count = 0;
+
+        for( std::string_view rest = line; ; )
+        {
+            if( count == kColumns ) { return false; }
+
+            const size_t comma = rest.find( ',' );
+            columns[count++] = Trim( rest.substr( 0, comma ) );
+            if( std::string_view::npos == comma ) { break; }
+            rest.remove_prefix( comma + 1 );
+        }
+
+        const std::string_view op = columns[1];
+        OrderBook::Command& command = message.command;
+        command = OrderBook::Command {};
+        message.symbol = columns[0];
+
+        if( message.symbol.empty() ) { return false; }
+
+        bool needs_side = false;
+        bool needs_id   = true;
+        bool needs_vol  = false;
+
+        if     ( "INSERT"        == op ) { command.type = OrderBook::Command::Type::INSERT;        needs_side = true; needs_vol = true; }
+        else if( "AMEND"         == op ) { command.type = OrderBook::Command::Type::AMEND;         needs_vol  = true; }
+        else if( "PULL"          == op ) { command.type = OrderBook::Command::Type::PULL;          }
+        else if( "START_AUCTION" == op ) { command.type = OrderBook::Command::Type::START_AUCTION; needs_id   = false; }
+        else if( "UNCROSS"       == op ) { command.type = OrderBook::Command::Type::UNCROSS;       needs_id   = false; }
+        else                             { return false; }
+
+        if( needs_id && !ParseNumber( columns[2], command.id ) ) { return false; }
+
+        if( needs_side )
+        {
+            if     ( "BUY"  == columns[3] ) { command.side = OrderBook::Side::BUY;  }
+            else if( "SELL" == columns[3] ) { command.side = OrderBook::Side::SELL; }
+            else                            { return false; }
+        }
+
+        if( needs_vol && ( !ParseNumber( columns[4], command.price ) || !ParseNumber( columns[5], command.vol ) ) ) { return false; }
+
+        return true;
+    }
+
+
+    /**
+     * @brief Calls 'fn(message)' for every message of the text 'data' and returns true, or
+     *        returns false with 'error_offset' set to the start of the first malformed line.
+     *        If 'data' is the start of the file, a header line whose first column is 'sym' may
+     *        come before the first message.
+     */
+    template< class Fn >
+    bool ForEachTextMessage( const std::string_view data, const bool file_start, Fn&& fn, size_t& error_offset )
+    {
+        Message message;
+        bool    first = file_start;
+
+        for( size_t begin = 0; begin < data.size(); )
+        {
+            const char*  newline = static_cast<const char*>( std::memchr( data.data() + begin, '\n', data.size() - begin ) );
+            const size_t end     = newline ? size_t( newline - data.data() ) : data.size();
+            const std::string_view line = Trim( data.substr( begin, end - begin ) );
+
+            if( !line.empty() && '#' != line.front() )
+            {
+                const bool header = first && "sym" == Trim( line.substr( 0, line.find( ',' ) ) );
+                first = false;
+
+                if( !header )
+                {
+                    if( !ParseLine( line, message ) ) { error_offset = begin; return false; }
+                    fn( message );
+                }
+            }
+
+            begin = end + 1;
+        }
+
+        return true;
+    }
+
+
+    /**
+     * @brief Converts a binary record to a message. Returns false if it is malformed.
+     */
+    bool ParseRecord( const OrderFlowReplayer::BinaryRecord& record, Message& message )
+    {
+        if( record.type > uint8_t( OrderBook::Command::Type::UNCROSS ) || record.side > uint8_t( OrderBook::Side::SELL ) ) { return false; }
+
+        message.symbol  = std::string_view( record.symbol, strnlen( record.symbol, sizeof(record.symbol) ) );
+        message.command = OrderBook::Command{ OrderBook::Command::Type( record.type ), OrderBook::Side( record.side ), record.id, record.price, record.vol };
+        return !message.symbol.empty();
+    }
+
+
+    [[noreturn]] void ThrowMalformed( const std::string& path, const size_t offset )
+    {
+        throw std::invalid_argument( "OrderFlowReplayer: malformed message at byte " + std::to_string( offset ) + " of " + path );
+    }
+}
+
+
+OrderFlowReplayer::OrderFlowReplayer( UniqueIDGenerator& id_gen, const size_t num_threads, BookFactory factory )
+: mIdGen   { id_gen },
+  mThreads { num_threads },
+  mFactory { std::move( factory ) },
+  mBooks   ( num_threads )
+{
+    if( 0 == num_threads )
+    {
+        throw std::invalid_argument( "OrderFlowReplayer: at least one thread is required" );
+    }
+
+    if( !mFactory )
+    {
+        mFactory = []( const std::string_view symbol, UniqueIDGenerator& gen ) { return std::make_unique<OrderBook>( std::string( symbol ), gen ); };
+    }
+}
+
+
+OrderFlowReplayer::Result OrderFlowReplayer::Replay( const std::string& path, const Format format )
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    const MappedFile file( path );
+    const char*      data = file.Data();
+    const size_t     size = file.Size();
+
+    // byte ranges of the chunks, text chunks end after a newline and binary chunks after a record
+    std::vector< std::pair<size_t, size_t> > chunks;
+
+    if( Format::TEXT == format )
+    {
+        for( size_t begin = 0; begin < size; )
+        {
+            size_t end = std::min( begin + kChunkBytes, size );
+            if( end < size )
+            {
+                const char* newline = static_cast<const char*>( std::memchr( data + end, '\n', size - end ) );
+                end = newline ? size_t( newline - data ) + 1 : size;
+            }
+
+            chunks.emplace_back( begin, end );
+            begin = end;
+        }
+    }
+    else
+    {
+        const auto* header = reinterpret_cast<const BinaryHeader*>( data );
+        if( size < sizeof(BinaryHeader) || 0 != std::memcmp( header->magic, kBinaryMagic, sizeof(kBinaryMagic) ) ||
+            kBinaryVersion != header->version || sizeof(BinaryRecord) != header->record_size ||
+            0 != ( size - sizeof(BinaryHeader) ) % sizeof(BinaryRecord) )
+        {
+            throw std::invalid_argument( "OrderFlowReplayer: not a binary capture " + path );
+        }
+
+        constexpr size_t kChunkRecordBytes = kChunkBytes / sizeof(BinaryRecord) * sizeof(BinaryRecord);
+        for( size_t begin = sizeof(BinaryHeader); begin < size; begin += kChunkRecordBytes )
+        {
+            chunks.emplace_back( begin, std::min( begin + kChunkRecordBytes, size ) );
+        }
+    }
+
+    // Every round, thread 't' parses chunk 'round * mThreads + t' into 'parsed[t]'. After a
+    // barrier, thread 't' applies the messages of its symbols from all chunks of the round in
+    // chunk order, which is file order.
+    std::vector<ParsedChunk> parsed( mThreads, ParsedChunk( mThreads ) );
+    std::vector<size_t>      commands( mThreads, 0 );
+    std::vector<size_t>      rejected( mThreads, 0 );
+    std::barrier<>           sync { std::ptrdiff_t( mThreads ) };
+    std::atomic<bool>        failed { false };        // A chunk of the round is malformed, only set while parsing.
+    std::atomic<bool>        apply_failed { false };  // An order book could not be created, only set while applying.
+    std::mutex               error_mutex;
+    std::exception_ptr       error;
+    size_t                   error_chunk = SIZE_MAX;
+
+    // keeps the exception of the earliest failing chunk, called from a catch block
+    auto fail = [&]( const size_t chunk, std::atomic<bool>& flag )
+    {
+        const std::lock_guard lock( error_mutex );
+        if( chunk < error_chunk ) { error = std::current_exception(); error_chunk = chunk; }
+        flag.store( true );
+    };
+
+    auto parse = [&]( const size_t chunk, ParsedChunk& out )
+    {
+        const auto [begin, end] = chunks[chunk];
+        auto route = [&]( const Message& message ) { out[ WorkerOf( message.symbol ) ].push_back( message ); };
+
+        if( Format::TEXT == format )
+        {
+            size_t offset = 0;
+            if( !ForEachTextMessage( std::string_view( data + begin, end - begin ), 0 == begin, route, offset ) ) { ThrowMalformed( path, begin + offset ); }
+        }
+        else
+        {
+            const auto* records = reinterpret_cast<const BinaryRecord*>( data + begin );
+            Message     message;
+
+            for( size_t i = 0; i < ( end - begin ) / sizeof(BinaryRecord); ++i )
+            {
+                if( !ParseRecord( records[i], message ) ) { ThrowMalformed( path, begin + i * sizeof(BinaryRecord) ); }
+                route( message );
+            }
+        }
+    };
+
+    auto apply = [&]( const size_t t, const size_t round )
+    {
+        BookMap&         books  = mBooks[t];
+        Book*            book   = nullptr;
+        std::string_view symbol;
+
+        for( size_t c = 0; c < mThreads; ++c )
+        {
+            for( const Message& message : parsed[c][t] )
+            {
+                // consecutive messages are often for the same symbol
+                if( nullptr == book || message.symbol != symbol )
+                {
+                    try
+                    {
+                        book = &FindOrCreate( books, message.symbol );
+                    }
+                    catch( ... )
+                    {
+                        // the factory could not create the order book, e.g. for a bad symbol
+                        fail( round * mThreads + c, apply_failed );
+                        return;
+                    }
+                    symbol = message.symbol;
+                }
+
+                ++book->commands;
+                ++commands[t];
+
+                try
+                {
+                    book->book->Apply( message.command );
+                }
+                catch( const std::exception& )
+                {
+                    ++book->rejected;
+                    ++rejected[t];
+                }
+            }
+        }
+    };
+
+    auto run = [&]( const size_t t )
+    {
+        for( size_t round = 0; round * mThreads < chunks.size(); ++round )
+        {
+            for( auto& messages : parsed[t] ) { messages.clear(); }
+
+            if( const size_t chunk = round * mThreads + t; chunk < chunks.size() )
+            {
+                try
+                {
+                    parse( chunk, parsed[t] );
+                }
+                catch( ... )
+                {
+                    fail( chunk, failed );
+                }
+            }
+
+            // nothing is applied from a round with a malformed chunk, every thread sees the same flag
+            sync.arrive_and_wait();
+            if( failed.load() ) { return; }
+
+            // the flags are checked after the barrier following the phase setting them, so no thread
+            // can return while the others still wait for it
+            apply( t, round );
+            sync.arrive_and_wait();
+            if( apply_failed.load() ) { return; }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for( size_t t = 1; t < mThreads; ++t )
+    {
+        threads.emplace_back( run, t );
+    }
+
+    run( 0 );
+
+    for( auto& thread : threads )
+    {
+        thread.join();
+    }
+
+    if( error ) { std::rethrow_exception( error ); }
+
+    Result result;
+    result.bytes = size;
+
+    for( size_t t = 0; t < mThreads; ++t )
+    {
+        result.commands += commands[t];
+        result.rejected += rejected[t];
+
+        for( const auto& [name, book] : mBooks[t] )
+        {
+            result.symbols.push_back( SymbolResult{ name, book.commands, book.rejected, book.trades, book.traded_volume, book.book->GetTopOfBook() } );
+        }
+    }
+
+    std::sort( result.symbols.begin(), result.symbols.end(), []( const SymbolResult& a, const SymbolResult& b ) { return a.symbol < b.symbol; } );
+
+    result.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    return result;
+}
+
+
+OrderBook* OrderFlowReplayer::GetBook( const std::string_view symbol )
+{
+    BookMap& books = mBooks[ WorkerOf( symbol ) ];
+    auto     it    = books.find( symbol );
+    return books.end() == it ? nullptr : it->second.book.get();
+}
+
+
+size_t OrderFlowReplayer::ConvertToBinary( const std::string& text_path, const std::string& binary_path )
+{
+    constexpr size_t kRecordsPerWrite = 4096;
+
+    const MappedFile text( text_path );
+
+    const int fd = ::open( binary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    if( fd < 0 ) { ThrowSystemError( "OrderFlowReplayer: cannot open " + binary_path ); }
+
+    size_t count = 0;
+
+    try
+    {
+        BinaryHeader header {};
+        std::memcpy( header.magic, kBinaryMagic, sizeof(kBinaryMagic) );
+        header.version     = kBinaryVersion;
+        header.record_size = sizeof(BinaryRecord);
+        WriteAll( fd, &header, sizeof(header) );
+
+        std::vector<BinaryRecord> buffer;
+        buffer.reserve( kRecordsPerWrite );
+
+        auto write_record = [&]( const Message& message )
+        {
+            if( message.symbol.size() > sizeof(BinaryRecord::symbol) )
+            {
+                throw std::invalid_argument( "OrderFlowReplayer: symbol longer than 8 characters " + std::string( message.symbol ) );
+            }
+
+            BinaryRecord record {};
+            std::memcpy( record.symbol, message.symbol.data(), message.symbol.size() );
+            record.type  = uint8_t( message.command.type );
+            record.side  = uint8_t( message.command.side );
+            record.id    = message.command.id;
+            record.price = message.command.price;
+            record.vol   = message.command.vol;
+            buffer.push_back( record );
+            ++count;
+
+            if( buffer.size() == kRecordsPerWrite )
+            {
+                WriteAll( fd, buffer.data(), buffer.size() * sizeof(BinaryRecord) );
+                buffer.clear();
+            }
+        };
+
+        size_t offset = 0;
+        if( !ForEachTextMessage( std::string_view( text.Data(), text.Size() ), true, write_record, offset ) ) { ThrowMalformed( text_path, offset ); }
+
+        WriteAll( fd, buffer.data(), buffer.size() * sizeof(BinaryRecord) );
+    }
+    catch( ... )
+    {
+        ::close( fd );
+        ::unlink( binary_path.c_str() );
+        throw;
+    }
+
+    ::close( fd );
+    return count;
+}
+
+
+OrderFlowReplayer::Book& OrderFlowReplayer::FindOrCreate( BookMap& books, const std::string_view symbol )
+{
+    if( auto it = books.find( symbol ); books.end() != it )
+    {
+        return it->second;
+    }
+
+    Book& book = books.emplace( std::string( symbol ), Book{ mFactory( symbol, mIdGen ) } ).first->second;
+
+    // nodes of an unordered map never move, so the sink can keep a reference to the counters
+    book.book->SetTradeSink( [&book]( const OrderBook::ExecutedTrade& trade )
+    {
+        ++book.trades;
+        book.traded_volume += trade.volume;
+    } );
+
+    return book;
+}
+
+
+size_t OrderFlowReplayer::WorkerOf( const std::string_view symbol ) const
+{
+    return SymbolHash()( symbol ) % mThreads;
+}
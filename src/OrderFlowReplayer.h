@@ -0,0 +1,193 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "OrderBook.h"
+#include "UniqueIDGenerator.h"
+
+/**
+ * @brief Replays captured order flow of many symbols into one 'OrderBook' per symbol.
+ *
+ * The capture file is memory mapped and cut into chunks which are parsed in parallel without
+ * allocating per message. Every symbol belongs to one worker thread, which applies the
+ * messages of its symbols chunk by chunk in file order, so each order book sees its messages in
+ * the order they were captured.
+ *
+ * Text captures have one message per line in the column order of the README example:
+ *
+ *     sym, op, id, side, price, vol
+ *     GOOG, INSERT, 1, BUY, 145.3, 17
+ *     GOOG, AMEND, 1, , 147.0, 50
+ *     GOOG, PULL, 1
+ *
+ * 'op' is one of INSERT, AMEND, PULL, START_AUCTION or UNCROSS and 'side' is BUY or SELL.
+ * Columns an operation does not use may be empty or, at the end of the line, left out. Blank
+ * lines, lines starting with '#' and a header line at the start whose first column is 'sym' are
+ * skipped. Binary captures are a 'BinaryHeader' followed
+ * by 'BinaryRecord's, see 'ConvertToBinary()'.
+ *
+ * Throws 'std::invalid_argument' for malformed captures and 'std::system_error' on I/O errors.
+ */
+class OrderFlowReplayer
+{
+public:
+
+    enum class Format
+    {
+        TEXT = 0,
+        BINARY
+    };
+
+
+    /**
+     * @brief Start of a binary capture.
+     */
+    struct BinaryHeader
+    {
+        char     magic[8];     // 'kBinaryMagic'
+        uint32_t version;      // 'kBinaryVersion'
+        uint32_t record_size;  // 'sizeof(BinaryRecord)'
+    };
+
+
+    /**
+     * @brief A message of a binary capture.
+     */
+    struct BinaryRecord
+    {
+        char     symbol[8];    // Zero padded if shorter than 8 characters.
+        uint8_t  type;         // 'OrderBook::Command::Type'
+        uint8_t  side;         // 'OrderBook::Side'
+        uint8_t  reserved[6];  // Always 0.
+        uint64_t id;
+        double   price;
+        uint64_t vol;
+    };
+
+    static_assert( sizeof(BinaryHeader) == 16 && sizeof(BinaryRecord) == 40, "capture records must have a fixed size" );
+
+
+    /**
+     * @brief Final state and counters of one symbol.
+     */
+    struct SymbolResult
+    {
+        std::string          symbol;
+        size_t               commands      = 0;  // Messages applied to the order book, over all replays.
+        size_t               rejected      = 0;  // Messages the order book threw an exception for.
+        size_t               trades        = 0;
+        uint64_t             traded_volume = 0;
+        OrderBook::PriceLevel top;               // Top of book after the replay.
+    };
+
+
+    /**
+     * @brief Summary of a replay.
+     */
+    struct Result
+    {
+        size_t bytes    = 0;                // Size of the capture file.
+        size_t commands = 0;                // Messages in the capture.
+        size_t rejected = 0;                // Messages the order books threw an exception for.
+        double seconds  = 0;                // Wall clock time of the replay, including mapping the file.
+        std::vector<SymbolResult> symbols;  // Sorted by symbol.
+    };
+
+
+    /**
+     * @brief Creates the order book of a symbol the first time it is seen. The default factory
+     *        uses 'OrderBook( symbol, id_gen )'. Called from the worker threads, possibly concurrently.
+     */
+    using BookFactory = std::function< std::unique_ptr<OrderBook>( std::string_view symbol, UniqueIDGenerator& id_gen ) >;
+
+
+    /**
+     * @param id_gen       Used for generating IDs for executed trades of all order books.
+     * @param num_threads  Number of worker threads. At least one.
+     * @param factory      Creates the order books, see 'BookFactory'.
+     */
+    OrderFlowReplayer( UniqueIDGenerator& id_gen, const size_t num_threads, BookFactory factory = {} );
+
+    OrderFlowReplayer( const OrderFlowReplayer& ) = delete;
+    OrderFlowReplayer& operator=( const OrderFlowReplayer& ) = delete;
+
+
+    /**
+     * @brief Replays the capture at 'path'. Order books are kept between calls, so a day split
+     *        over several files can be replayed file by file. If the capture is malformed, the
+     *        messages of the chunks before the malformed one may already have been applied. An
+     *        exception of the 'BookFactory' is rethrown the same way, once the other threads
+     *        have applied the messages of the current round.
+     */
+    Result Replay( const std::string& path, const Format format );
+
+
+    /**
+     * @brief Returns the order book of 'symbol' or nullptr if it has not been seen.
+     */
+    OrderBook* GetBook( std::string_view symbol );
+
+
+    /**
+     * @brief Writes the text capture at 'text_path' as a binary capture to 'binary_path'.
+     *        Symbols may be at most 8 characters long.
+     *
+     * @return Number of messages written.
+     */
+    static size_t ConvertToBinary( const std::string& text_path, const std::string& binary_path );
+
+
+    static constexpr char     kBinaryMagic[8] { 'O', 'B', 'F', 'L', 'O', 'W', '0', '1' };
+    static constexpr uint32_t kBinaryVersion  { 1 };
+
+
+private:
+
+    /**
+     * @brief Order book of a symbol and its counters, only used by the worker owning the symbol.
+     */
+    struct Book
+    {
+        std::unique_ptr<OrderBook> book;
+        size_t   commands      = 0;
+        size_t   rejected      = 0;
+        size_t   trades        = 0;
+        uint64_t traded_volume = 0;
+    };
+
+
+    /**
+     * @brief Hash of 'std::string' and 'std::string_view', so books can be found without building a string.
+     */
+    struct SymbolHash
+    {
+        using is_transparent = void;
+        size_t operator()( const std::string_view symbol ) const { return std::hash<std::string_view>()( symbol ); }
+    };
+
+    using BookMap = std::unordered_map< std::string, Book, SymbolHash, std::equal_to<> >;
+
+
+    /**
+     * @brief Returns the book of 'symbol' in 'books', creating it if needed.
+     */
+    Book& FindOrCreate( BookMap& books, const std::string_view symbol );
+
+
+    /**
+     * @brief Returns the worker thread owning 'symbol'.
+     */
+    size_t WorkerOf( const std::string_view symbol ) const;
+
+
+    UniqueIDGenerator& mIdGen;                       // Used for generating IDs for executed trades.
+    const size_t mThreads;                           // Number of worker threads.
+    BookFactory mFactory;                            // Creates the order books.
+    std::vector<BookMap> mBooks;                     // Order books of each worker, by symbol.
+};
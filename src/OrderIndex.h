@@ -0,0 +1,203 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief Maps order ids to order handles. Open addressing hash table with linear probing, stored
+ *        in one flat array, so a lookup usually touches a single cache line and inserting does not
+ *        allocate. Erasing shifts the following entries of the probe sequence back instead of
+ *        leaving tombstones, so lookups do not slow down over a long session of inserts and pulls.
+ *
+ * The table doubles when it becomes more than half full. 'Reserve()' sizes it up front so the
+ * hot path never rehashes. 'Id' is the integer type of the order ids, a 32-bit type halves the
+ * size of the table.
+ */
+template< class Id = size_t >
+class BasicOrderIndex
+{
+public:
+
+    using Handle = std::uint32_t;
+
+    static constexpr Handle kNil = ~Handle(0);  // Returned by 'Find()' for unknown ids, never a valid handle.
+
+
+    /**
+     * @brief Construct an empty index which allocates its table from 'resource'.
+     */
+    explicit BasicOrderIndex( std::pmr::memory_resource* resource = std::pmr::get_default_resource() )
+    : mSlots { resource }
+    {
+    }
+
+
+    /**
+     * @brief Returns the handle of order 'id' or 'kNil'.
+     */
+    Handle Find( const Id id ) const
+    {
+        if( mSlots.empty() ) { return kNil; }
+
+        for( size_t i = Home( id ); ; i = ( i + 1 ) & mMask )
+        {
+            const Slot& slot = mSlots[i];
+            if( kNil == slot.handle ) { return kNil; }
+            if( id == slot.id )       { return slot.handle; }
+        }
+    }
+
+
+    /**
+     * @brief Adds 'id' with 'handle'. Does nothing and returns false if 'id' is already present.
+     */
+    bool Insert( const Id id, const Handle handle )
+    {
+        if( 2 * ( mSize + 1 ) > mSlots.size() )
+        {
+            Rehash( std::max<size_t>( kMinSlots, 2 * mSlots.size() ) );
+        }
+
+        size_t i = Home( id );
+        for( ; kNil != mSlots[i].handle; i = ( i + 1 ) & mMask )
+        {
+            if( id == mSlots[i].id ) { return false; }
+        }
+
+        mSlots[i] = Slot{ id, handle };
+        ++mSize;
+        return true;
+    }
+
+
+    /**
+     * @brief Removes 'id'. Returns false if it is not present.
+     */
+    bool Erase( const Id id )
+    {
+        if( mSlots.empty() ) { return false; }
+
+        size_t hole = Home( id );
+        for( ; mSlots[hole].id != id || kNil == mSlots[hole].handle; hole = ( hole + 1 ) & mMask )
+        {
+            if( kNil == mSlots[hole].handle ) { return false; }
+        }
+
+        // move entries which probed past the hole back into it, until the probe sequence ends
+        for( size_t i = ( hole + 1 ) & mMask; kNil != mSlots[i].handle; i = ( i + 1 ) & mMask )
+        {
+            const size_t home = Home( mSlots[i].id );
+
+            // the entry may only move if its home is not in the cyclic range (hole, i]
+            if( ( ( i - home ) & mMask ) >= ( ( i - hole ) & mMask ) )
+            {
+                mSlots[hole] = mSlots[i];
+                hole = i;
+            }
+        }
+
+        mSlots[hole].handle = kNil;
+        --mSize;
+        return true;
+    }
+
+
+    /**
+     * @brief Hints the CPU to load the slot 'id' would be found at into the cache.
+     */
+    void Prefetch( const Id id ) const
+    {
+        if( !mSlots.empty() ) { __builtin_prefetch( &mSlots[ Home( id ) ] ); }
+    }
+
+
+    /**
+     * @brief Makes room for 'count' ids, so inserting them does not rehash.
+     */
+    void Reserve( const size_t count )
+    {
+        const size_t slots = std::bit_ceil( std::max<size_t>( kMinSlots, 2 * count ) );
+        if( slots > mSlots.size() ) { Rehash( slots ); }
+    }
+
+
+    /**
+     * @brief Removes all ids and gives the memory of the table back to the memory resource.
+     */
+    void Release()
+    {
+        std::pmr::vector<Slot>( mSlots.get_allocator() ).swap( mSlots );
+        mSize  = 0;
+        mMask  = 0;
+        mShift = 64;
+    }
+
+
+    size_t Size()     const { return mSize; }
+    bool   Empty()    const { return 0 == mSize; }
+    size_t Capacity() const { return mSlots.size() / 2; }  // Number of ids which fit without rehashing.
+
+
+    /**
+     * @brief Returns the number of bytes allocated for the table.
+     */
+    size_t MemoryUsage() const
+    {
+        return mSlots.capacity() * sizeof(Slot);
+    }
+
+
+private:
+
+    struct Slot
+    {
+        Id     id     { 0 };
+        Handle handle { kNil };  // 'kNil' if the slot is unused.
+    };
+
+    static constexpr size_t kMinSlots = 16;
+
+
+    /**
+     * @brief Slot at which the search for 'id' starts. Fibonacci hashing: takes the top bits of a
+     *        multiplication, so dense ids and ids with a common stride both spread over the table.
+     */
+    size_t Home( const Id id ) const
+    {
+        return size_t( ( uint64_t(id) * 0x9E3779B97F4A7C15ull ) >> mShift );
+    }
+
+
+    /**
+     * @brief Moves all entries into a table of 'slots' slots, a power of two.
+     */
+    void Rehash( const size_t slots )
+    {
+        std::pmr::vector<Slot> old( slots, mSlots.get_allocator() );
+        old.swap( mSlots );
+
+        mMask  = slots - 1;
+        mShift = 64 - unsigned( std::countr_zero( slots ) );
+
+        for( const Slot& slot : old )
+        {
+            if( kNil == slot.handle ) { continue; }
+
+            size_t i = Home( slot.id );
+            while( kNil != mSlots[i].handle ) { i = ( i + 1 ) & mMask; }
+            mSlots[i] = slot;
+        }
+    }
+
+
+    std::pmr::vector<Slot> mSlots;  // Power of two number of slots, at most half of them used.
+    size_t   mSize  { 0 };          // Number of used slots.
+    size_t   mMask  { 0 };          // 'mSlots.size() - 1'
+    unsigned mShift { 64 };         // 64 - log2( mSlots.size() )
+};
+
+
+using OrderIndex = BasicOrderIndex<>;
@@ -0,0 +1,168 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief Slab allocator for fixed size objects. Objects are stored contiguously and referred
+ *        to by a 32-bit handle. Freed slots are recycled before the slab grows.
+ *
+ * Every object has a hot part 'T' and a cold part 'Cold', stored in separate arrays indexed by
+ * the same handle, so walking the hot parts does not pull the cold ones into the cache.
+ *
+ * NOTE: Growing the slab invalidates references to its objects, handles stay valid.
+ */
+template< class T, class Cold >
+class OrderPool
+{
+public:
+
+    using Handle = std::uint32_t;
+
+    static constexpr Handle kNil = ~Handle(0);  // Handle which never refers to an object.
+
+
+    /**
+     * @brief Construct an empty pool which allocates its slab from 'resource'.
+     */
+    explicit OrderPool( std::pmr::memory_resource* resource = std::pmr::get_default_resource() )
+    : mSlab { resource },
+      mCold { resource },
+      mFree { resource }
+    {
+    }
+
+
+    /**
+     * @brief Returns a handle to an unused slot. The slot keeps whatever the previous user left in it.
+     */
+    Handle Allocate()
+    {
+        if( !mFree.empty() )
+        {
+            const Handle handle = mFree.back();
+            mFree.pop_back();
+            return handle;
+        }
+
+        mSlab.emplace_back();
+        mCold.emplace_back();
+        return Handle( mSlab.size() - 1 );
+    }
+
+
+    /**
+     * @brief Returns the slot of 'handle' to the pool.
+     */
+    void Free( const Handle handle )
+    {
+        mFree.push_back( handle );
+    }
+
+
+    /**
+     * @brief Makes room for 'count' objects so that allocating and freeing them does not grow
+     *        the slab or the free list.
+     */
+    void Reserve( const size_t count )
+    {
+        mSlab.reserve( count );
+        mCold.reserve( count );
+        mFree.reserve( count );
+    }
+
+
+    /**
+     * @brief Returns the number of objects the slab can hold before it has to grow.
+     */
+    size_t Capacity() const
+    {
+        return mSlab.capacity();
+    }
+
+
+    /**
+     * @brief Frees all objects and gives the memory of the slab back to the memory resource.
+     *        All handles become invalid.
+     */
+    void Release()
+    {
+        std::pmr::vector<T>( mSlab.get_allocator() ).swap( mSlab );
+        std::pmr::vector<Cold>( mCold.get_allocator() ).swap( mCold );
+        std::pmr::vector<Handle>( mFree.get_allocator() ).swap( mFree );
+    }
+
+
+    /**
+     * @brief Returns the number of bytes allocated for the slab and the free list.
+     */
+    size_t MemoryUsage() const
+    {
+        return mSlab.capacity() * sizeof(T) + mCold.capacity() * sizeof(Cold) + mFree.capacity() * sizeof(Handle);
+    }
+
+
+    T&       operator[]( const Handle handle )       { return mSlab[ handle ]; }
+    const T& operator[]( const Handle handle ) const { return mSlab[ handle ]; }
+
+    Cold&       GetCold( const Handle handle )       { return mCold[ handle ]; }
+    const Cold& GetCold( const Handle handle ) const { return mCold[ handle ]; }
+
+
+private:
+
+    std::pmr::vector<T>      mSlab;  // Hot part of all slots, used and unused.
+    std::pmr::vector<Cold>   mCold;  // Cold part of all slots.
+    std::pmr::vector<Handle> mFree;  // Unused slots in 'mSlab'.
+};
+
+
+
+/**
+ * @brief Intrusive doubly linked FIFO of pooled objects. 'T' must have 'prev' and 'next' handles.
+ */
+struct OrderQueue
+{
+    using Handle = std::uint32_t;
+
+    static constexpr Handle kNil = ~Handle(0);
+
+    Handle head { kNil };  // Oldest object, i.e. the one with 'time priority'.
+    Handle tail { kNil };  // Newest object.
+
+    bool empty() const { return kNil == head; }
+
+
+    /**
+     * @brief Appends 'handle' at the end of the queue.
+     */
+    template< class Pool >
+    void PushBack( Pool& pool, const Handle handle )
+    {
+        auto& item = pool[ handle ];
+        item.prev  = tail;
+        item.next  = kNil;
+
+        if( kNil == tail ) { head = handle; }
+        else               { pool[ tail ].next = handle; }
+
+        tail = handle;
+    }
+
+
+    /**
+     * @brief Removes 'handle' from the queue in O(1). 'handle' must be in this queue.
+     */
+    template< class Pool >
+    void Unlink( Pool& pool, const Handle handle )
+    {
+        auto& item = pool[ handle ];
+
+        if( kNil == item.prev ) { head = item.next; }
+        else                    { pool[ item.prev ].next = item.next; }
+
+        if( kNil == item.next ) { tail = item.prev; }
+        else                    { pool[ item.next ].prev = item.prev; }
+    }
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Throws a 'std::system_error' for the current 'errno'.
+ */
+[[noreturn]] inline void ThrowSystemError( const std::string& what )
+{
+    throw std::system_error( errno, std::generic_category(), what );
+}
+
+
+/**
+ * @brief Writes all 'size' bytes of 'data' to 'fd', retrying short writes.
+ */
+inline void WriteAll( const int fd, const void* data, size_t size )
+{
+    const char* bytes = static_cast<const char*>( data );
+
+    while( size > 0 )
+    {
+        const ssize_t written = ::write( fd, bytes, size );
+
+        if( written < 0 )
+        {
+            if( EINTR == errno ) { continue; }
+            ThrowSystemError( "write failed" );
+        }
+
+        bytes += written;
+        size  -= size_t(written);
+    }
+}
+
+
+/**
+ * @brief Read only memory mapping of a whole file. The mapping is removed on destruction.
+ */
+class MappedFile
+{
+public:
+
+    /**
+     * @brief Maps the file at 'path'. Throws 'std::system_error' if the file cannot be mapped.
+     */
+    explicit MappedFile( const std::string& path )
+    {
+        const int fd = ::open( path.c_str(), O_RDONLY );
+        if( fd < 0 ) { ThrowSystemError( "cannot open " + path ); }
+
+        struct stat info;
+        if( ::fstat( fd, &info ) < 0 ) { ::close( fd ); ThrowSystemError( "cannot stat " + path ); }
+
+        mSize = size_t(info.st_size);
+
+        if( mSize > 0 )
+        {
+            mData = ::mmap( nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if( MAP_FAILED == mData ) { ::close( fd ); ThrowSystemError( "cannot map " + path ); }
+
+            ::madvise( mData, mSize, MADV_SEQUENTIAL );
+        }
+
+        ::close( fd );
+    }
+
+    ~MappedFile()
+    {
+        if( mSize > 0 ) { ::munmap( mData, mSize ); }
+    }
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    const char* Data() const { return static_cast<const char*>( mData ); }
+    size_t      Size() const { return mSize; }
+
+private:
+
+    void*  mData { nullptr };  // Start of the mapping.
+    size_t mSize { 0 };        // Size of the file in bytes.
+};
@@ -0,0 +1,495 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <vector>
+
+#include "OccupancyBitmap.h"
+
+/*
+ * Price levels of one side of an order book, keyed by integer tick. 'kSell' is true for the
+ * sell side, whose best price is the lowest one, and false for the buy side, whose best price
+ * is the highest one. The side is a template parameter, so comparing prices never branches on it.
+ *
+ * 'SparsePriceLadder' stores the levels in a 'std::map' and has an unbounded price range.
+ * 'DensePriceLadder' stores the levels in a flat array indexed by the tick offset from the lowest
+ * tick of a price band, plus an 'OccupancyBitmap' of the non empty levels, so moving to the next
+ * best level never scans empty ticks. 'PriceLadder' picks one of the two at runtime. In all of
+ * them the best price is available in O(1).
+ *
+ * 'Level' must be default constructible and provide 'empty()'. All ladders have the same
+ * interface, so an order book can use any of them.
+ */
+
+
+/**
+ * @brief Price levels in a 'std::map', for an unbounded price range.
+ */
+template< class Level, bool kSell >
+class SparsePriceLadder
+{
+public:
+
+    using Tick = std::int64_t;
+
+
+    /**
+     * @param resource  Memory resource of the price levels.
+     */
+    explicit SparsePriceLadder( std::pmr::memory_resource* resource = std::pmr::get_default_resource() )
+    : mLevels { resource }
+    {
+    }
+
+
+    /**
+     * @brief Returns true if there are no price levels in the ladder.
+     */
+    bool Empty() const
+    {
+        return mLevels.empty();
+    }
+
+
+    /**
+     * @brief Returns the tick of the best price level. Ladder may not be empty.
+     */
+    Tick BestTick() const
+    {
+        if constexpr( kSell ) { return mLevels.begin()->first; }
+        else                  { return mLevels.rbegin()->first; }
+    }
+
+
+    /**
+     * @brief Returns the best price level. Ladder may not be empty.
+     */
+    Level& Best()
+    {
+        if constexpr( kSell ) { return mLevels.begin()->second; }
+        else                  { return mLevels.rbegin()->second; }
+    }
+
+
+    /**
+     * @brief Returns the level at 'tick' or nullptr if there is no such level.
+     */
+    Level* Find( const Tick tick )
+    {
+        auto it = mLevels.find( tick );
+        return it == mLevels.end() ? nullptr : &it->second;
+    }
+
+    const Level* Find( const Tick tick ) const
+    {
+        return const_cast<SparsePriceLadder*>( this )->Find( tick );
+    }
+
+
+    /**
+     * @brief Returns the level at 'tick', creating it if needed. The caller must add at least
+     *        one order to a newly created level.
+     */
+    Level& Get( const Tick tick )
+    {
+        return mLevels[ tick ];
+    }
+
+
+    /**
+     * @brief Removes the level at 'tick'. Must be called once the level has become empty.
+     */
+    void Remove( const Tick tick )
+    {
+        mLevels.erase( tick );
+    }
+
+
+    /**
+     * @brief Removes all levels with ticks in [first, last], whether empty or not. The caller
+     *        must have disposed of the orders of these levels.
+     */
+    void RemoveRange( const Tick first, const Tick last )
+    {
+        if( first > last ) { return; }
+        mLevels.erase( mLevels.lower_bound( first ), mLevels.upper_bound( last ) );
+    }
+
+
+    /**
+     * @brief Returns true if 'tick' can be stored in the ladder.
+     */
+    bool InRange( const Tick ) const
+    {
+        return true;
+    }
+
+
+    /**
+     * @brief Nothing to prefetch, the address of a level is only known after searching the map.
+     */
+    void Prefetch( const Tick ) const
+    {
+    }
+
+
+    /**
+     * @brief Calls 'fn(tick, level)' for each level, starting with the best price. Iteration
+     *        stops early if 'fn' returns false.
+     */
+    template< class Fn >
+    void ForEach( Fn&& fn ) const
+    {
+        if constexpr( kSell )
+        {
+            for( auto it = mLevels.cbegin(); it != mLevels.cend(); ++it )
+            {
+                if( !fn( it->first, it->second ) ) { return; }
+            }
+        }
+        else
+        {
+            for( auto it = mLevels.crbegin(); it != mLevels.crend(); ++it )
+            {
+                if( !fn( it->first, it->second ) ) { return; }
+            }
+        }
+    }
+
+
+    /**
+     * @brief Removes all levels and gives their memory back to the memory resource.
+     */
+    void Release()
+    {
+        std::pmr::map<Tick, Level>( mLevels.get_allocator() ).swap( mLevels );
+    }
+
+
+    /**
+     * @brief Counterpart of 'DensePriceLadder::Allocate()', nothing to do.
+     */
+    void Allocate()
+    {
+    }
+
+
+    /**
+     * @brief Returns the number of bytes allocated for the levels. Estimated, as the size of a
+     *        map node is not visible: a red-black tree node holds a color and three pointers.
+     */
+    size_t MemoryUsage() const
+    {
+        return mLevels.size() * NodeSize();
+    }
+
+
+    /**
+     * @brief Returns the bytes allocated from the memory resource for every level, estimated
+     *        like in 'MemoryUsage()'.
+     */
+    static constexpr size_t NodeSize()
+    {
+        return sizeof( typename decltype(mLevels)::value_type ) + 4 * sizeof(void*);
+    }
+
+
+private:
+
+    std::pmr::map<Tick, Level> mLevels;  // Non empty levels.
+};
+
+
+
+/**
+ * @brief Price levels in a flat array covering a fixed price band, lookups are O(1).
+ */
+template< class Level, bool kSell >
+class DensePriceLadder
+{
+public:
+
+    using Tick = std::int64_t;
+
+
+    /**
+     * @brief Construct a ladder covering the ticks [min_tick, max_tick].
+     *
+     * @param min_tick  Lowest tick that can be stored.
+     * @param max_tick  Highest tick that can be stored.
+     * @param resource  Memory resource of the price levels.
+     */
+    DensePriceLadder( const Tick min_tick, const Tick max_tick, std::pmr::memory_resource* resource = std::pmr::get_default_resource() )
+    : mMinTick { min_tick },
+      mMaxTick { max_tick },
+      mLevels  ( size_t(max_tick - min_tick + 1), resource ),
+      mOccupied { size_t(max_tick - min_tick + 1), resource }
+    {
+    }
+
+
+    /**
+     * @brief Construct an empty ladder which can not store any tick, see 'PriceLadder'.
+     */
+    explicit DensePriceLadder( std::pmr::memory_resource* resource = std::pmr::get_default_resource() )
+    : mMinTick { 0 },
+      mMaxTick { -1 },
+      mLevels  { resource },
+      mOccupied { 0, resource }
+    {
+    }
+
+
+    bool Empty() const
+    {
+        return kNoLevel == mBest;
+    }
+
+
+    Tick BestTick() const
+    {
+        return mMinTick + mBest;
+    }
+
+
+    Level& Best()
+    {
+        return mLevels[ size_t(mBest) ];
+    }
+
+
+    Level* Find( const Tick tick )
+    {
+        Level& level = mLevels[ size_t(tick - mMinTick) ];
+        return level.empty() ? nullptr : &level;
+    }
+
+    const Level* Find( const Tick tick ) const
+    {
+        return const_cast<DensePriceLadder*>( this )->Find( tick );
+    }
+
+
+    Level& Get( const Tick tick )
+    {
+        const std::ptrdiff_t index = tick - mMinTick;
+
+        if( kNoLevel == mBest || IsBetter( index, mBest ) )
+        {
+            mBest = index;
+        }
+
+        mOccupied.Set( size_t(index) );
+        return mLevels[ size_t(index) ];
+    }
+
+
+    void Remove( const Tick tick )
+    {
+        mOccupied.Clear( size_t(tick - mMinTick) );
+
+        if( tick - mMinTick == mBest )
+        {
+            mBest = Next( mBest );
+        }
+    }
+
+
+    void RemoveRange( Tick first, Tick last )
+    {
+        first = std::max( first, mMinTick );
+        last  = std::min( last,  mMaxTick );
+        if( first > last ) { return; }
+
+        const size_t end = size_t(last - mMinTick) + 1;
+        for( size_t i = mOccupied.NextSet( size_t(first - mMinTick) ); i < end; i = mOccupied.NextSet( i + 1 ) )
+        {
+            mLevels[i] = Level{};
+            mOccupied.Clear( i );
+        }
+
+        if( kNoLevel != mBest && first - mMinTick <= mBest && mBest <= last - mMinTick )
+        {
+            mBest = kSell ? Next( last - mMinTick ) : Next( first - mMinTick );
+        }
+    }
+
+
+    bool InRange( const Tick tick ) const
+    {
+        return mMinTick <= tick && tick <= mMaxTick;
+    }
+
+
+    /**
+     * @brief Hints the CPU to load the level at 'tick' into the cache. 'tick' may be outside the price band.
+     */
+    void Prefetch( const Tick tick ) const
+    {
+        if( InRange( tick ) )
+        {
+            __builtin_prefetch( &mLevels[ size_t(tick - mMinTick) ], 1 );
+        }
+    }
+
+
+    template< class Fn >
+    void ForEach( Fn&& fn ) const
+    {
+        for( std::ptrdiff_t i = mBest; kNoLevel != i; i = Next( i ) )
+        {
+            if( !fn( mMinTick + i, mLevels[ size_t(i) ] ) ) { return; }
+        }
+    }
+
+
+    /**
+     * @brief Removes all levels and gives their memory back to the memory resource. 'Allocate()'
+     *        must be called before the ladder is used again.
+     */
+    void Release()
+    {
+        std::pmr::vector<Level>( mLevels.get_allocator() ).swap( mLevels );
+        mOccupied.Release();
+        mBest = kNoLevel;
+    }
+
+
+    /**
+     * @brief Allocates the flat array again after 'Release()'.
+     */
+    void Allocate()
+    {
+        mLevels.resize( size_t(mMaxTick - mMinTick + 1) );
+        mOccupied.Resize( size_t(mMaxTick - mMinTick + 1) );
+    }
+
+
+    /**
+     * @brief Returns the number of bytes allocated for the levels and the occupancy bitmap.
+     */
+    size_t MemoryUsage() const
+    {
+        return mLevels.capacity() * sizeof(Level) + mOccupied.MemoryUsage();
+    }
+
+
+    /**
+     * @brief Counterpart of 'SparsePriceLadder::NodeSize()'. 0, as all levels are allocated up front.
+     */
+    static constexpr size_t NodeSize()
+    {
+        return 0;
+    }
+
+
+private:
+
+    static constexpr std::ptrdiff_t kNoLevel = -1;
+
+
+    /**
+     * @brief Returns true if the level at index 'a' has a better price than the one at 'b'.
+     */
+    static bool IsBetter( const std::ptrdiff_t a, const std::ptrdiff_t b )
+    {
+        if constexpr( kSell ) { return a < b; }
+        else                  { return a > b; }
+    }
+
+
+    /**
+     * @brief Returns the index of the first non empty level after 'index', moving away from the
+     *        spread, or 'kNoLevel'.
+     */
+    std::ptrdiff_t Next( const std::ptrdiff_t index ) const
+    {
+        if constexpr( kSell )
+        {
+            const size_t next = mOccupied.NextSet( size_t(index) + 1 );
+            return OccupancyBitmap::kNone == next ? kNoLevel : std::ptrdiff_t(next);
+        }
+        else
+        {
+            // 'PrevSet( kNone )' for index 0 would return the highest level, so stop here
+            if( 0 == index ) { return kNoLevel; }
+
+            const size_t next = mOccupied.PrevSet( size_t(index) - 1 );
+            return OccupancyBitmap::kNone == next ? kNoLevel : std::ptrdiff_t(next);
+        }
+    }
+
+
+    const Tick mMinTick;                          // Tick of 'mLevels[0]'.
+    const Tick mMaxTick;                          // Tick of 'mLevels.back()'.
+    std::ptrdiff_t mBest { kNoLevel };            // Index of the best level in 'mLevels'.
+    std::pmr::vector<Level> mLevels;              // All levels in the price band.
+    OccupancyBitmap mOccupied;                    // Non empty levels of 'mLevels'.
+};
+
+
+
+/**
+ * @brief Either a 'DensePriceLadder' or a 'SparsePriceLadder', chosen by the constructor.
+ */
+template< class Level, bool kSell >
+class PriceLadder
+{
+public:
+
+    using Tick = std::int64_t;
+
+
+    /**
+     * @brief Construct a sparse ladder with an unbounded price range.
+     */
+    explicit PriceLadder( std::pmr::memory_resource* resource = std::pmr::get_default_resource() )
+    : mDense  { resource },
+      mSparse { resource }
+    {
+    }
+
+
+    /**
+     * @brief Construct a dense ladder covering the ticks [min_tick, max_tick].
+     */
+    PriceLadder( const Tick min_tick, const Tick max_tick, std::pmr::memory_resource* resource = std::pmr::get_default_resource() )
+    : mIsDense { true },
+      mDense   { min_tick, max_tick, resource },
+      mSparse  { resource }
+    {
+    }
+
+
+    bool         Empty()    const                { return mIsDense ? mDense.Empty()    : mSparse.Empty();    }
+    Tick         BestTick() const                { return mIsDense ? mDense.BestTick() : mSparse.BestTick(); }
+    Level&       Best()                          { return mIsDense ? mDense.Best()     : mSparse.Best();     }
+    Level*       Find( const Tick tick )         { return mIsDense ? mDense.Find(tick) : mSparse.Find(tick); }
+    const Level* Find( const Tick tick ) const   { return mIsDense ? mDense.Find(tick) : mSparse.Find(tick); }
+    Level&       Get( const Tick tick )          { return mIsDense ? mDense.Get(tick)  : mSparse.Get(tick);  }
+    bool         InRange( const Tick tick ) const { return !mIsDense || mDense.InRange( tick ); }
+
+    void Remove( const Tick tick )         { if( mIsDense ) { mDense.Remove( tick );   } else { mSparse.Remove( tick );   } }
+    void RemoveRange( const Tick first, const Tick last ) { if( mIsDense ) { mDense.RemoveRange( first, last ); } else { mSparse.RemoveRange( first, last ); } }
+    void Prefetch( const Tick tick ) const { if( mIsDense ) { mDense.Prefetch( tick ); } else { mSparse.Prefetch( tick ); } }
+    void Release()                         { mDense.Release();  mSparse.Release();  }
+    void Allocate()                        { if( mIsDense ) { mDense.Allocate(); } }
+    size_t MemoryUsage() const             { return mDense.MemoryUsage() + mSparse.MemoryUsage(); }
+    size_t NodeSize() const                { return mIsDense ? mDense.NodeSize() : mSparse.NodeSize(); }
+
+    template< class Fn >
+    void ForEach( Fn&& fn ) const
+    {
+        if( mIsDense ) { mDense.ForEach( fn ); }
+        else           { mSparse.ForEach( fn ); }
+    }
+
+
+private:
+
+    const bool mIsDense { false };
+    DensePriceLadder<Level, kSell>  mDense;   // Used if 'mIsDense'.
+    SparsePriceLadder<Level, kSell> mSparse;  // Used otherwise.
+};
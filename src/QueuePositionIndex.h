@@ -0,0 +1,167 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/*
+ * Queue position policies of the price levels of 'BasicOrderBook', chosen by the 'QueuePositions'
+ * member of its traits. Every order of a level gets a slot when it joins the level; slots
+ * increase from the front to the back of the level's FIFO. 'GetQueuePosition()' asks the policy
+ * for the volume and number of orders in the slots before an order's slot.
+ *
+ * 'QueuePositionIndex' answers in O(log n) from a Fenwick tree over the slots, at the cost of an
+ * O(log n) update whenever an order joins, leaves or trades. 'NoQueuePositionIndex' keeps nothing,
+ * the order book then walks the FIFO instead.
+ */
+
+
+/**
+ * @brief Volume and number of orders ahead of an order in its price level.
+ */
+struct QueueAhead
+{
+    uint64_t volume = 0;
+    uint64_t orders = 0;
+
+    auto operator<=>(const QueueAhead&) const = default;
+};
+
+
+/**
+ * @brief Fenwick tree of the volume and order count of every slot of a price level. Allocator
+ *        aware, so the tree lives in the memory resource of the price level containing it.
+ */
+class QueuePositionIndex
+{
+public:
+
+    static constexpr bool kEnabled = true;
+
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+
+    QueuePositionIndex() = default;
+
+    explicit QueuePositionIndex( const allocator_type& alloc )
+    : mTree { alloc }
+    {
+    }
+
+    QueuePositionIndex( const QueuePositionIndex& other, const allocator_type& alloc )
+    : mTree { other.mTree, alloc }
+    {
+    }
+
+    QueuePositionIndex( QueuePositionIndex&& other, const allocator_type& alloc )
+    : mTree { std::move( other.mTree ), alloc }
+    {
+    }
+
+    QueuePositionIndex( const QueuePositionIndex& ) = default;
+    QueuePositionIndex( QueuePositionIndex&& ) = default;
+    QueuePositionIndex& operator=( const QueuePositionIndex& ) = default;
+    QueuePositionIndex& operator=( QueuePositionIndex&& ) = default;
+
+
+    /**
+     * @brief Adds a slot holding one order of volume 'vol' behind all others and returns it.
+     */
+    uint32_t Append( const uint64_t vol )
+    {
+        // node i sums the slots (i - lowbit(i), i], made of 'vol' and the nodes covering the rest
+        const size_t i = mTree.size() + 1;
+        QueueAhead node { vol, 1 };
+
+        for( size_t j = i - 1; j > i - LowBit( i ); j -= LowBit( j ) )
+        {
+            node.volume += mTree[j - 1].volume;
+            node.orders += mTree[j - 1].orders;
+        }
+
+        mTree.push_back( node );
+        return uint32_t( i - 1 );
+    }
+
+
+    /**
+     * @brief Takes 'vol' from the order in 'slot', e.g. after a partial fill.
+     */
+    void Reduce( const uint32_t slot, const uint64_t vol )
+    {
+        for( size_t i = size_t(slot) + 1; i <= mTree.size(); i += LowBit( i ) ) { mTree[i - 1].volume -= vol; }
+    }
+
+
+    /**
+     * @brief Removes the order of volume 'vol' in 'slot'. The slot stays empty until 'Clear()'.
+     */
+    void Remove( const uint32_t slot, const uint64_t vol )
+    {
+        for( size_t i = size_t(slot) + 1; i <= mTree.size(); i += LowBit( i ) )
+        {
+            mTree[i - 1].volume -= vol;
+            mTree[i - 1].orders -= 1;
+        }
+    }
+
+
+    /**
+     * @brief Returns the volume and number of orders in the slots before 'slot'.
+     */
+    QueueAhead Ahead( const uint32_t slot ) const
+    {
+        QueueAhead ahead;
+        for( size_t i = slot; i > 0; i -= LowBit( i ) )
+        {
+            ahead.volume += mTree[i - 1].volume;
+            ahead.orders += mTree[i - 1].orders;
+        }
+        return ahead;
+    }
+
+
+    /**
+     * @brief Returns the number of slots, used and empty.
+     */
+    size_t Slots() const { return mTree.size(); }
+
+
+    /**
+     * @brief Removes all slots, keeping the memory.
+     */
+    void Clear() { mTree.clear(); }
+
+
+private:
+
+    static size_t LowBit( const size_t i ) { return i & ( ~i + 1 ); }
+
+    std::pmr::vector<QueueAhead> mTree;  // 'mTree[i - 1]' is node i of the Fenwick tree.
+};
+
+
+/**
+ * @brief Drop in replacement for 'QueuePositionIndex' which keeps nothing and compiles away.
+ */
+class NoQueuePositionIndex
+{
+public:
+
+    static constexpr bool kEnabled = false;
+
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    NoQueuePositionIndex() = default;
+    explicit NoQueuePositionIndex( const allocator_type& ) {}
+    NoQueuePositionIndex( const NoQueuePositionIndex&, const allocator_type& ) {}
+    NoQueuePositionIndex( const NoQueuePositionIndex& ) = default;
+    NoQueuePositionIndex& operator=( const NoQueuePositionIndex& ) = default;
+
+    uint32_t   Append( const uint64_t )                 { return 0; }
+    void       Reduce( const uint32_t, const uint64_t ) {}
+    void       Remove( const uint32_t, const uint64_t ) {}
+    QueueAhead Ahead( const uint32_t ) const            { return {}; }
+    size_t     Slots() const                            { return 0; }
+    void       Clear()                                  {}
+};
@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Fixed capacity, lock free, single producer single consumer queue. The storage is
+ *        allocated once at construction, so pushing never allocates. One thread may call
+ *        'TryPush()' while another thread calls 'TryPop()'.
+ */
+template< class T >
+class SpscRingBuffer
+{
+public:
+
+    /**
+     * @brief Construct a new ring buffer.
+     *
+     * @param capacity  Minimum number of elements the buffer can hold. Rounded up to a power of two.
+     */
+    explicit SpscRingBuffer( const size_t capacity )
+    : mBuffer ( std::bit_ceil( capacity < 2 ? size_t(2) : capacity ) ),
+      mMask   { mBuffer.size() - 1 }
+    {
+    }
+
+
+    /**
+     * @brief Adds 'item' at the back of the queue. Producer thread only.
+     *
+     * @return False if the queue is full, in which case nothing is added.
+     */
+    bool TryPush( const T& item )
+    {
+        const size_t tail = mTail.load( std::memory_order_relaxed );
+
+        if( tail - mCachedHead == mBuffer.size() )
+        {
+            mCachedHead = mHead.load( std::memory_order_acquire );
+            if( tail - mCachedHead == mBuffer.size() ) { return false; }
+        }
+
+        mBuffer[ tail & mMask ] = item;
+        mTail.store( tail + 1, std::memory_order_release );
+        return true;
+    }
+
+
+    /**
+     * @brief Removes the element at the front of the queue and stores it in 'item'. Consumer thread only.
+     *
+     * @return False if the queue is empty, in which case 'item' is left unchanged.
+     */
+    bool TryPop( T& item )
+    {
+        const size_t head = mHead.load( std::memory_order_relaxed );
+
+        if( head == mCachedTail )
+        {
+            mCachedTail = mTail.load( std::memory_order_acquire );
+            if( head == mCachedTail ) { return false; }
+        }
+
+        item = mBuffer[ head & mMask ];
+        mHead.store( head + 1, std::memory_order_release );
+        return true;
+    }
+
+
+    /**
+     * @brief Returns the number of elements in the queue. Only exact when neither thread is active.
+     */
+    size_t Size() const
+    {
+        return mTail.load( std::memory_order_acquire ) - mHead.load( std::memory_order_acquire );
+    }
+
+
+    /**
+     * @brief Returns the maximum number of elements the queue can hold.
+     */
+    size_t Capacity() const
+    {
+        return mBuffer.size();
+    }
+
+
+private:
+
+    static constexpr size_t kCacheLineSize = 64;
+
+    std::vector<T> mBuffer;                                    // Element storage, size is a power of two.
+    const size_t   mMask;                                      // Maps a position to an index in 'mBuffer'.
+
+    alignas(kCacheLineSize) std::atomic<size_t> mHead { 0 };   // Next position to pop. Written by consumer.
+    size_t mCachedTail { 0 };                                  // Consumer's copy of 'mTail'.
+
+    alignas(kCacheLineSize) std::atomic<size_t> mTail { 0 };   // Next position to push. Written by producer.
+    size_t mCachedHead { 0 };                                  // Producer's copy of 'mHead'.
+};
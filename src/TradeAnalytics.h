@@ -0,0 +1,133 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Open, high, low and close price, in ticks, and volume of a series of trades.
+ */
+struct TickBar
+{
+    uint64_t start  = 0;  // Start of the interval of the bar, in the time unit given to 'TradeAnalytics::Record()'.
+    int64_t  open   = 0;
+    int64_t  high   = 0;
+    int64_t  low    = 0;
+    int64_t  close  = 0;
+    uint64_t volume = 0;
+    uint64_t trades = 0;
+
+    void Add( const int64_t tick, const uint64_t vol )
+    {
+        if( 0 == trades )
+        {
+            open = high = low = tick;
+        }
+
+        high    = std::max( high, tick );
+        low     = std::min( low, tick );
+        close   = tick;
+        volume += vol;
+        trades += 1;
+    }
+
+    auto operator<=>(const TickBar&) const = default;
+};
+
+
+/**
+ * @brief Running statistics of the trades of an order book, updated in O(1) on every trade so
+ *        nobody has to scan the list of trades. Optionally keeps a bar for each of the latest
+ *        'count' time intervals in a ring allocated up front by 'SetBars()'.
+ */
+class TradeAnalytics
+{
+public:
+
+    /**
+     * @brief Starts keeping a bar per 'interval' for the latest 'count' intervals, dropping the
+     *        bars kept so far. A 'count' of 0 stops keeping bars.
+     */
+    void SetBars( const uint64_t interval, const size_t count )
+    {
+        mInterval = std::max<uint64_t>( interval, 1 );
+        mBars.assign( count, TickBar{} );
+        mNewest   = 0;
+        mBarCount = 0;
+    }
+
+
+    bool HasBars() const { return !mBars.empty(); }
+
+
+    /**
+     * @brief Adds a trade of 'vol' at 'tick'. 'now' is the time of the trade, only used for the
+     *        bars. Times before the current bar are counted in the current bar.
+     */
+    void Record( const int64_t tick, const uint64_t vol, const uint64_t now )
+    {
+        mTotals.Add( tick, vol );
+        mNotional += double(tick) * double(vol);
+
+        if( mBars.empty() ) { return; }
+
+        const uint64_t start = now - now % mInterval;
+        if( 0 == mBarCount || start > mBars[mNewest].start )
+        {
+            mNewest   = 0 == mBarCount ? 0 : ( mNewest + 1 ) % mBars.size();
+            mBarCount = std::min( mBarCount + 1, mBars.size() );
+            mBars[mNewest] = TickBar{ start };
+        }
+
+        mBars[mNewest].Add( tick, vol );
+    }
+
+
+    /**
+     * @brief Returns open, high, low and last price and volume of all trades. 'start' is 0.
+     */
+    const TickBar& Totals() const { return mTotals; }
+
+
+    /**
+     * @brief Returns the sum of price in ticks times volume of all trades.
+     */
+    double Notional() const { return mNotional; }
+
+
+    /**
+     * @brief Returns the number of bars kept, at most the 'count' given to 'SetBars()'.
+     */
+    size_t BarCount() const { return mBarCount; }
+
+
+    /**
+     * @brief Returns bar 'i' of the bars kept, 0 being the oldest.
+     */
+    const TickBar& Bar( const size_t i ) const
+    {
+        return mBars[ ( mNewest + mBars.size() - mBarCount + 1 + i ) % mBars.size() ];
+    }
+
+
+    /**
+     * @brief Forgets all trades, but keeps the bar interval and ring.
+     */
+    void Clear()
+    {
+        mTotals   = TickBar{};
+        mNotional = 0;
+        mNewest   = 0;
+        mBarCount = 0;
+    }
+
+
+private:
+
+    TickBar  mTotals;                // All trades.
+    double   mNotional { 0 };        // Sum of tick times volume of all trades.
+    uint64_t mInterval { 1 };        // Length of the interval of a bar.
+    std::vector<TickBar> mBars;      // Ring of the latest bars.
+    size_t   mNewest   { 0 };        // Index of the newest bar in 'mBars'.
+    size_t   mBarCount { 0 };        // Number of bars in 'mBars' holding trades.
+};
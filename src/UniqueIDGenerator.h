@@ -4,10 +4,11 @@
 
 /**
  * @brief Generates unique IDs sequentially. It is thread safe using atomics.
- * NOTE: The ID can overflow so depending on use, it might have to be reset
- * in a controlled way by calling 'Reset()'.
+ * The counter sits on its own cache line so that it does not share a line with other data.
+ * Threads which generate many IDs should lease blocks of IDs through 'IDBlockLease', which
+ * only touches the shared counter once per block.
  */
-class UniqueIDGenerator 
+class alignas(64) UniqueIDGenerator
 {
 public:
     UniqueIDGenerator() : m_id(0) {}
@@ -17,18 +18,124 @@ public:
      */
     size_t GenerateID()
     {
-        return m_id.fetch_add(1);
+        return m_id.fetch_add(1, std::memory_order_relaxed);
     }
 
     /**
-     * @brief Resets id to 0.
-     * 
+     * @brief Reserves 'count' sequential IDs with a single atomic operation. Is thread safe.
+     *
+     * @return The first of the reserved IDs.
+     */
+    size_t ReserveBlock( const size_t count )
+    {
+        return m_id.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the ID which will be handed out next. Is thread safe, but the value may
+     * be outdated by the time it is used if other threads are generating IDs.
+     */
+    size_t PeekNextID() const
+    {
+        return m_id.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Makes sure no ID below 'id' is handed out from now on, e.g. when restoring from a
+     * snapshot. Never moves the generator backwards. Is thread safe.
+     */
+    void AdvanceTo( const size_t id )
+    {
+        size_t current = m_id.load(std::memory_order_relaxed);
+        while( current < id && !m_id.compare_exchange_weak(current, id, std::memory_order_relaxed) ) {}
+    }
+
+    /**
+     * @brief Starts a new epoch, i.e. the next ID is 'epoch << kEpochShift'. Is thread safe:
+     * IDs generated or leased before the reset can never be generated again, so it may be
+     * called at any time (e.g. at the start of a trading day) without coordinating with the
+     * users of the generator.
      */
     void Reset()
     {
-        m_id.store(0);
+        size_t id = m_id.load(std::memory_order_relaxed);
+        while( !m_id.compare_exchange_weak(id, (id | kSequenceMask) + 1, std::memory_order_relaxed) ) {}
     }
 
+    /**
+     * @brief Returns the current epoch, i.e. the number of times 'Reset()' has been called
+     * unless more than 2^48 IDs were generated in an epoch.
+     */
+    size_t GetEpoch() const
+    {
+        return m_id.load(std::memory_order_relaxed) >> kEpochShift;
+    }
+
+    static constexpr unsigned kEpochShift    = 48;
+    static constexpr size_t   kSequenceMask  = (size_t(1) << kEpochShift) - 1;
+
 private:
     std::atomic<size_t> m_id;
-};
\ No newline at end of file
+};
+
+
+/**
+ * @brief Hands out IDs from blocks reserved from a shared 'UniqueIDGenerator', so the shared
+ * counter is only touched once per block. Not thread safe, use one lease per thread or order book.
+ * NOTE: With a block size larger than 1, IDs are unique but no longer ordered across leases.
+ * A block size of 1 keeps one global order of IDs across all users of the generator.
+ */
+class IDBlockLease
+{
+public:
+    explicit IDBlockLease( UniqueIDGenerator& source, const size_t block_size = 1 )
+    : m_source(source),
+      m_block_size(block_size < 1 ? 1 : block_size)
+    {
+    }
+
+    /**
+     * @brief Generates a unique id, reserving a new block from the shared generator if needed.
+     */
+    size_t GenerateID()
+    {
+        if( m_next == m_end )
+        {
+            m_next = m_source.ReserveBlock(m_block_size);
+            m_end  = m_next + m_block_size;
+        }
+
+        return m_next++;
+    }
+
+    /**
+     * @brief Changes the number of IDs reserved at a time. IDs left in the current block are dropped.
+     */
+    void SetBlockSize( const size_t block_size )
+    {
+        m_block_size = block_size < 1 ? 1 : block_size;
+        Discard();
+    }
+
+    /**
+     * @brief Drops the IDs left in the current block, the next ID comes from a new block.
+     */
+    void Discard()
+    {
+        m_next = m_end;
+    }
+
+    /**
+     * @brief Returns the number of IDs reserved at a time.
+     */
+    size_t GetBlockSize() const
+    {
+        return m_block_size;
+    }
+
+private:
+    UniqueIDGenerator& m_source;
+    size_t m_block_size;
+    size_t m_next { 0 };  // next ID to hand out
+    size_t m_end  { 0 };  // one past the last ID of the current block
+};
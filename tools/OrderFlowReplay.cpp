@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <thread>
+
+#include "OrderFlowReplayer.h"
+#include "UniqueIDGenerator.h"
+
+/*
+ * Replays a captured order flow file, see 'OrderFlowReplayer.h' for the formats.
+ *
+ *     OrderFlowReplay [--binary] [--threads N] [--quiet] <capture>
+ *     OrderFlowReplay --convert <text capture> <binary capture>
+ */
+
+namespace
+{
+    int Usage()
+    {
+        std::fprintf( stderr,
+                      "usage: OrderFlowReplay [--binary] [--threads N] [--quiet] <capture>\n"
+                      "       OrderFlowReplay --convert <text capture> <binary capture>\n" );
+        return 2;
+    }
+
+
+    void PrintResult( const OrderFlowReplayer::Result& result, const bool quiet )
+    {
+        const double seconds = result.seconds > 0 ? result.seconds : 1e-9;
+
+        std::printf( "messages:   %zu (%zu rejected)\n", result.commands, result.rejected );
+        std::printf( "symbols:    %zu\n", result.symbols.size() );
+        std::printf( "time:       %.3f s\n", result.seconds );
+        std::printf( "throughput: %.2f M messages/s, %.1f MB/s\n", double( result.commands ) / seconds / 1e6, double( result.bytes ) / seconds / 1e6 );
+
+        if( quiet ) { return; }
+
+        std::printf( "\n%-10s %12s %10s %8s %14s %12s %10s %12s %10s\n",
+                     "symbol", "messages", "rejected", "trades", "traded vol", "bid", "bid vol", "ask", "ask vol" );
+
+        for( const auto& symbol : result.symbols )
+        {
+            std::printf( "%-10s %12zu %10zu %8zu %14llu %12.4f %10zu %12.4f %10zu\n",
+                         symbol.symbol.c_str(), symbol.commands, symbol.rejected, symbol.trades, static_cast<unsigned long long>( symbol.traded_volume ),
+                         symbol.top.buy_price, symbol.top.buy_vol, symbol.top.sell_price, symbol.top.sell_vol );
+        }
+    }
+}
+
+
+int main( int argc, char** argv )
+{
+    auto format  = OrderFlowReplayer::Format::TEXT;
+    size_t threads = std::max( 1u, std::thread::hardware_concurrency() );
+    bool quiet   = false;
+    std::string path;
+
+    try
+    {
+        for( int i = 1; i < argc; ++i )
+        {
+            if( 0 == std::strcmp( argv[i], "--convert" ) )
+            {
+                if( i + 2 >= argc ) { return Usage(); }
+
+                const size_t count = OrderFlowReplayer::ConvertToBinary( argv[i + 1], argv[i + 2] );
+                std::printf( "converted %zu messages\n", count );
+                return 0;
+            }
+            else if( 0 == std::strcmp( argv[i], "--binary" ) )                  { format  = OrderFlowReplayer::Format::BINARY; }
+            else if( 0 == std::strcmp( argv[i], "--quiet" ) )                   { quiet   = true; }
+            else if( 0 == std::strcmp( argv[i], "--threads" ) && i + 1 < argc ) { threads = std::strtoul( argv[++i], nullptr, 10 ); }
+            else if( path.empty() && '-' != argv[i][0] )                       { path    = argv[i]; }
+            else                                                               { return Usage(); }
+        }
+
+        if( path.empty() || 0 == threads ) { return Usage(); }
+
+        UniqueIDGenerator id_gen;
+        OrderFlowReplayer replayer( id_gen, threads );
+        PrintResult( replayer.Replay( path, format ), quiet );
+    }
+    catch( const std::exception& e )
+    {
+        std::fprintf( stderr, "OrderFlowReplay: %s\n", e.what() );
+        return 1;
+    }
+
+    return 0;
+}
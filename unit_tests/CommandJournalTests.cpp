@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "CommandJournal.h"
+#include "OrderBook.h"
+
+namespace
+{
+    std::string JournalPath( const std::string& name )
+    {
+        const auto path = std::filesystem::temp_directory_path() / ( "OrderBookTests_" + name + ".journal" );
+        std::filesystem::remove( path );
+        return path.string();
+    }
+}
+
+
+TEST(CommandJournalTests, ReplayRebuildsOrderBook)
+{
+    const std::string path = JournalPath( "Replay" );
+
+    UniqueIDGenerator id_gen;
+    OrderBook tsla("TSLA", id_gen);
+    {
+        CommandJournal journal( path, CommandJournal::FsyncPolicy::NEVER, 2 );
+        tsla.SetJournal( &journal );
+
+        tsla.Insert( 2, OrderBook::Side::SELL, 201.2, 121 );
+        tsla.Insert( 3, OrderBook::Side::SELL, 205.5,  68 );
+        tsla.Insert( 5, OrderBook::Side::SELL, 205.5, 204 );
+        tsla.Insert( 6, OrderBook::Side::SELL, 206.9,  41 );
+        tsla.Pull  ( 6 );
+        tsla.Pull  ( 42 );                                     // Unknown order, not journaled.
+        tsla.Amend ( 3, 205.5, 75);
+        tsla.Insert( 8, OrderBook::Side::BUY, 209.8,  300 );
+
+        tsla.SetJournal( nullptr );
+    }
+
+    UniqueIDGenerator replay_id_gen;
+    OrderBook replayed("TSLA", replay_id_gen);
+    ASSERT_EQ( 7, CommandJournal::Replay( path, replayed ) );
+
+    ASSERT_EQ( tsla.GetPriceLevels(),  replayed.GetPriceLevels() );
+    ASSERT_EQ( tsla.GetListOfTrades(), replayed.GetListOfTrades() );
+
+    std::filesystem::remove( path );
+}
+
+
+TEST(CommandJournalTests, ReplayKeepsOwnersRepricesAndTimeInForce)
+{
+    const std::string path = JournalPath( "Owners" );
+
+    UniqueIDGenerator id_gen;
+    OrderBook book("TSLA", id_gen, 0.5, 1.0, 100.0);
+    {
+        CommandJournal journal( path, CommandJournal::FsyncPolicy::NEVER );
+        book.SetJournal( &journal );
+
+        book.Insert( 1, OrderBook::Side::SELL, 10.0, 5, 3 );
+        book.Insert( 2, OrderBook::Side::SELL, 11.0, 5, 4 );
+        book.Reprice( OrderBook::Side::SELL, 2, 4 );
+        book.CancelOwner( 3 );                                  // Journaled as a pull.
+        book.Insert( 3, OrderBook::Side::BUY, 12.0, 1, 5 );
+        book.Insert( 4, OrderBook::Side::BUY, 12.0, 2, 5, OrderBook::TimeInForce::IOC );
+
+        book.SetJournal( nullptr );
+    }
+
+    UniqueIDGenerator replay_id_gen;
+    OrderBook replayed("TSLA", replay_id_gen, 0.5, 1.0, 100.0);
+    ASSERT_EQ( 6, CommandJournal::Replay( path, replayed ) );
+
+    ASSERT_EQ( book.GetPriceLevels(),  replayed.GetPriceLevels() );
+    ASSERT_EQ( book.GetListOfTrades(), replayed.GetListOfTrades() );
+
+    // owners survive the replay
+    ASSERT_EQ( 1, replayed.CancelOwner( 4 ) );
+    ASSERT_TRUE( replayed.GetPriceLevels().empty() );
+
+    std::filesystem::remove( path );
+}
+
+
+TEST(CommandJournalTests, AppendAfterTornRecord)
+{
+    const std::string path = JournalPath( "Torn" );
+
+    {
+        CommandJournal journal( path, CommandJournal::FsyncPolicy::EVERY_RECORD );
+        journal.Append( { OrderBook::Command::Type::INSERT, OrderBook::Side::BUY, 1, 10.0, 5 } );
+    }
+
+    // simulate a crash in the middle of writing a record
+    {
+        std::ofstream file( path, std::ios::binary | std::ios::app );
+        file.write( "garbage", 7 );
+    }
+
+    {
+        CommandJournal journal( path, CommandJournal::FsyncPolicy::EVERY_BATCH );
+        journal.Append( { OrderBook::Command::Type::INSERT, OrderBook::Side::SELL, 2, 10.0, 3 } );
+    }
+
+    UniqueIDGenerator id_gen;
+    OrderBook book("MSFT", id_gen);
+    ASSERT_EQ( 2, CommandJournal::Replay( path, book ) );
+    ASSERT_EQ( 1, book.GetListOfTrades().size() );
+    ASSERT_EQ( OrderBook::PriceLevel(10.0, 2, 0, 0), book.GetTopOfBook() );
+
+    std::filesystem::remove( path );
+}
+
+
+TEST(CommandJournalTests, ReadsVersionOneAndRejectsNewerVersions)
+{
+    const std::string path = JournalPath( "Version" );
+
+    auto read_version = [&path]()
+    {
+        uint32_t version = 0;
+        std::ifstream file( path, std::ios::binary );
+        file.seekg( 8 );
+        file.read( reinterpret_cast<char*>( &version ), sizeof(version) );
+        return version;
+    };
+
+    auto write_version = [&path]( const uint32_t version )
+    {
+        std::fstream file( path, std::ios::binary | std::ios::in | std::ios::out );
+        file.seekp( 8 );
+        file.write( reinterpret_cast<const char*>( &version ), sizeof(version) );
+    };
+
+    {
+        CommandJournal journal( path, CommandJournal::FsyncPolicy::EVERY_RECORD );
+        journal.Append( { OrderBook::Command::Type::INSERT, OrderBook::Side::BUY, 1, 10.0, 5 } );
+    }
+    ASSERT_EQ( 2, read_version() );
+
+    // a journal written before owners and time in force existed
+    write_version( 1 );
+    {
+        UniqueIDGenerator id_gen;
+        OrderBook book("MSFT", id_gen);
+        ASSERT_EQ( 1, CommandJournal::Replay( path, book ) );
+        ASSERT_EQ( OrderBook::PriceLevel(10.0, 5, 0, 0), book.GetTopOfBook() );
+    }
+
+    // appending upgrades it, so an older reader never sees newer records
+    {
+        CommandJournal journal( path, CommandJournal::FsyncPolicy::EVERY_RECORD );
+        journal.Append( { OrderBook::Command::Type::INSERT, OrderBook::Side::SELL, 2, 11.0, 3, 0, OrderBook::TimeInForce::IOC } );
+    }
+    ASSERT_EQ( 2, read_version() );
+
+    write_version( 3 );
+    {
+        UniqueIDGenerator id_gen;
+        OrderBook book("MSFT", id_gen);
+        ASSERT_THROW( CommandJournal::Replay( path, book ), std::system_error );
+        ASSERT_THROW( CommandJournal journal( path ), std::system_error );
+    }
+
+    std::filesystem::remove( path );
+}
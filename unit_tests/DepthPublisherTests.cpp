@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+#include "DepthPublisher.h"
+#include "OrderBook.h"
+
+TEST(DepthPublisherTests, PublishAndRead)
+{
+    DepthPublisher<OrderBook::PriceLevel> publisher(2);
+    std::array<OrderBook::PriceLevel, 4> out;
+    uint64_t version = 99;
+
+    ASSERT_EQ( 0, publisher.Read( out, &version ) );
+    ASSERT_EQ( 0, version );
+
+    const std::array<OrderBook::PriceLevel, 3> levels { OrderBook::PriceLevel( 10, 1, 11, 2 ),
+                                                        OrderBook::PriceLevel(  9, 3, 12, 4 ),
+                                                        OrderBook::PriceLevel(  8, 5, 13, 6 ) };
+    publisher.Publish( levels );
+
+    ASSERT_EQ( 2, publisher.Read( out, &version ) );
+    ASSERT_EQ( 1, version );
+    ASSERT_EQ( levels[0], out[0] );
+    ASSERT_EQ( levels[1], out[1] );
+
+    ASSERT_EQ( 1, publisher.Read( std::span<OrderBook::PriceLevel>( out.data(), 1 ) ) );
+}
+
+
+TEST(DepthPublisherTests, OrderBookPublishesTopLevels)
+{
+    UniqueIDGenerator id_gen;
+    OrderBook book("GOOG", id_gen);
+    OrderBook::DepthPublisher publisher(3);
+    std::array<OrderBook::PriceLevel, 3> out;
+
+    book.SetDepthPublisher( &publisher );
+    ASSERT_EQ( 1, publisher.Version() );
+    ASSERT_EQ( 0, publisher.Read( out ) );
+
+    book.Insert( 1, OrderBook::Side::BUY,  100, 10 );
+    book.Insert( 2, OrderBook::Side::BUY,   99, 20 );
+    book.Insert( 3, OrderBook::Side::SELL, 101,  5 );
+    book.Pull( 42 );  // unknown order, nothing changes
+    ASSERT_EQ( 4, publisher.Version() );
+
+    ASSERT_EQ( 2, publisher.Read( out ) );
+    ASSERT_EQ( OrderBook::PriceLevel( 100, 10, 101, 5 ), out[0] );
+    ASSERT_EQ( OrderBook::PriceLevel(  99, 20,   0, 0 ), out[1] );
+
+    book.Insert( 4, OrderBook::Side::SELL, 100, 10 );
+    ASSERT_EQ( 1, publisher.Read( out ) );
+    ASSERT_EQ( OrderBook::PriceLevel( 99, 20, 101, 5 ), out[0] );
+
+    book.Reset();
+    ASSERT_EQ( 0, publisher.Read( out ) );
+
+    book.SetDepthPublisher( nullptr );
+    book.Insert( 5, OrderBook::Side::BUY, 100, 10 );
+    ASSERT_EQ( 0, publisher.Read( out ) );
+}
+
+
+TEST(DepthPublisherTests, ReadersOnlySeeConsistentSnapshots)
+{
+    constexpr size_t kLevels  = 8;
+    constexpr size_t kUpdates = 100000;
+
+    DepthPublisher<OrderBook::PriceLevel> publisher(kLevels);
+    std::atomic<bool> done { false };
+
+    // every publication has all fields of all levels set to the same value
+    auto reader = [&]
+    {
+        std::array<OrderBook::PriceLevel, kLevels> out;
+        uint64_t last = 0;
+
+        while( !done.load() )
+        {
+            uint64_t version = 0;
+            const size_t count = publisher.Read( out, &version );
+            EXPECT_GE( version, last );
+            last = version;
+
+            for( size_t i = 0; i < count; ++i )
+            {
+                EXPECT_EQ( out[0].buy_vol, out[i].buy_vol );
+                EXPECT_EQ( out[0].buy_vol, out[i].sell_vol );
+                EXPECT_EQ( double( out[0].buy_vol ), out[i].buy_price );
+            }
+        }
+    };
+
+    std::thread first( reader );
+    std::thread second( reader );
+
+    std::array<OrderBook::PriceLevel, kLevels> levels;
+    for( size_t update = 1; update <= kUpdates; ++update )
+    {
+        levels.fill( OrderBook::PriceLevel( double(update), update, double(update), update ) );
+        publisher.Publish( std::span<const OrderBook::PriceLevel>( levels.data(), 1 + update % kLevels ) );
+    }
+
+    done = true;
+    first.join();
+    second.join();
+
+    ASSERT_EQ( kUpdates, publisher.Version() );
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "HugePageResource.h"
+#include "OrderBook.h"
+
+TEST(HugePageResourceTests, CarvesBlocksOffTheRegion)
+{
+    HugePageResource resource( 1000 );
+    ASSERT_EQ( HugePageResource::kHugePageSize, resource.Capacity() );
+    ASSERT_EQ( 0, resource.Used() );
+
+    void* a = resource.allocate( 100, 8 );
+    void* b = resource.allocate( 100, 64 );
+    ASSERT_EQ( 0, reinterpret_cast<uintptr_t>( b ) % 64 );
+    ASSERT_GE( resource.Used(), 200 );
+    std::memset( a, 1, 100 );
+    std::memset( b, 2, 100 );
+
+    // does not fit anymore
+    void* large = resource.allocate( HugePageResource::kHugePageSize, 8 );
+    ASSERT_EQ( HugePageResource::kHugePageSize, resource.FallbackBytes() );
+    resource.deallocate( large, HugePageResource::kHugePageSize, 8 );
+    ASSERT_EQ( 0, resource.FallbackBytes() );
+
+    // freed blocks are reused once all are freed
+    resource.deallocate( a, 100, 8 );
+    ASSERT_GE( resource.Used(), 200 );
+    resource.deallocate( b, 100, 64 );
+    ASSERT_EQ( 0, resource.Used() );
+    ASSERT_EQ( a, resource.allocate( 100, 8 ) );
+}
+
+
+TEST(HugePageResourceTests, ReservedOrderBookDoesNotGrow)
+{
+    HugePageResource resource( 16 * 1024 * 1024 );
+    UniqueIDGenerator id_gen;
+    OrderBook book("GOOG", id_gen, &resource);
+
+    constexpr size_t kLevels = 100;
+    constexpr size_t kOrders = 10000;
+    book.Reserve( kOrders + 1, kLevels, kOrders );  // the aggressive order is stored before it trades
+    const OrderBook::MemoryUsage reserved = book.GetMemoryUsage();
+
+    for( size_t id = 1; id <= kOrders; ++id )
+    {
+        const OrderBook::Side side = id % 2 ? OrderBook::Side::BUY : OrderBook::Side::SELL;
+        const double distance = double( id % kLevels );
+        book.Insert( id, side, OrderBook::Side::BUY == side ? 100.0 - distance : 100.5 + distance, 10 );
+    }
+    book.Insert( kOrders + 1, OrderBook::Side::BUY, 200.0, 10 * kOrders / 4 );  // trades against a quarter of the sell orders
+
+    const OrderBook::MemoryUsage used = book.GetMemoryUsage();
+    ASSERT_EQ( kOrders / 4, book.GetListOfTrades().size() );
+    ASSERT_EQ( reserved.orders,         used.orders );
+    ASSERT_EQ( reserved.order_index,    used.order_index );
+    ASSERT_EQ( reserved.touched_levels, used.touched_levels );
+    ASSERT_EQ( reserved.arena,          used.arena );
+    ASSERT_EQ( reserved.trades,         used.trades );
+    ASSERT_EQ( 0, resource.FallbackBytes() );
+
+    // everything is given back on reset, so the region is used again from the start
+    book.Reset();
+    ASSERT_EQ( 0, resource.Used() );
+}
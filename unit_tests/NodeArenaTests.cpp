@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "NodeArena.h"
+
+TEST(NodeArenaTests, RecyclesBlocksPerSizeClass)
+{
+    NodeArena arena;
+
+    void* a = arena.allocate( 24 );
+    void* b = arena.allocate( 24 );
+    void* c = arena.allocate( 40 );
+    ASSERT_NE( a, b );
+    ASSERT_EQ( 0, reinterpret_cast<uintptr_t>( c ) % NodeArena::kGranularity );
+    ASSERT_EQ( NodeArena::kMinChunkSize, arena.GetChunkBytes() );
+
+    arena.deallocate( a, 24 );
+    ASSERT_NE( a, arena.allocate( 40 ) );  // different size class
+    ASSERT_EQ( a, arena.allocate( 32 ) );  // same size class as 24 bytes
+
+    // large blocks are not pooled
+    void* large = arena.allocate( 4 * NodeArena::kMaxBlockSize );
+    arena.deallocate( large, 4 * NodeArena::kMaxBlockSize );
+    ASSERT_EQ( NodeArena::kMinChunkSize, arena.GetChunkBytes() );
+
+    arena.release();
+    ASSERT_EQ( 0, arena.GetChunkBytes() );
+}
+
+
+TEST(NodeArenaTests, GrowsByDoublingChunks)
+{
+    NodeArena arena;
+
+    const size_t blocks = 2 * NodeArena::kMinChunkSize / NodeArena::kMaxBlockSize;
+    for( size_t i = 0; i < blocks; ++i )
+    {
+        ASSERT_NE( nullptr, arena.allocate( NodeArena::kMaxBlockSize ) );
+    }
+
+    ASSERT_EQ( 3 * NodeArena::kMinChunkSize, arena.GetChunkBytes() );
+}
+
+
+TEST(NodeArenaTests, ReserveTakesMemoryUpFront)
+{
+    NodeArena arena;
+    arena.Reserve( 10000, 40 );
+
+    const size_t reserved = arena.GetChunkBytes();
+    ASSERT_GE( reserved, 10000 * 48 );
+
+    for( size_t i = 0; i < 9999; ++i )
+    {
+        ASSERT_NE( nullptr, arena.allocate( 40 ) );
+    }
+
+    // enough room left, nothing to do
+    arena.Reserve( 1, 40 );
+    ASSERT_NE( nullptr, arena.allocate( 40 ) );
+    ASSERT_EQ( reserved, arena.GetChunkBytes() );
+
+    arena.Reserve( 1, 40 );
+    ASSERT_GT( arena.GetChunkBytes(), reserved );
+}
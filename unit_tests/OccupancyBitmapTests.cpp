@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+#include "OccupancyBitmap.h"
+
+TEST(OccupancyBitmapTests, NextAndPrevAcrossWordsAndSummaries)
+{
+    OccupancyBitmap bitmap( 100000 );
+    ASSERT_EQ( OccupancyBitmap::kNone, bitmap.NextSet( 0 ) );
+    ASSERT_EQ( OccupancyBitmap::kNone, bitmap.PrevSet( 99999 ) );
+
+    bitmap.Set( 63 );
+    bitmap.Set( 64 );
+    bitmap.Set( 99999 );
+    ASSERT_TRUE( bitmap.Test( 63 ) );
+    ASSERT_FALSE( bitmap.Test( 62 ) );
+
+    ASSERT_EQ( 63,    bitmap.NextSet( 0 ) );
+    ASSERT_EQ( 64,    bitmap.NextSet( 64 ) );
+    ASSERT_EQ( 99999, bitmap.NextSet( 65 ) );
+    ASSERT_EQ( OccupancyBitmap::kNone, bitmap.NextSet( 100000 ) );
+
+    ASSERT_EQ( 99999, bitmap.PrevSet( OccupancyBitmap::kNone ) );
+    ASSERT_EQ( 64,    bitmap.PrevSet( 99998 ) );
+    ASSERT_EQ( 63,    bitmap.PrevSet( 63 ) );
+    ASSERT_EQ( OccupancyBitmap::kNone, bitmap.PrevSet( 62 ) );
+
+    bitmap.Clear( 64 );
+    bitmap.Clear( 63 );
+    ASSERT_EQ( 99999, bitmap.NextSet( 0 ) );
+    ASSERT_EQ( OccupancyBitmap::kNone, bitmap.PrevSet( 99998 ) );
+}
+
+
+TEST(OccupancyBitmapTests, MatchesOrderedSet)
+{
+    constexpr size_t kSlots = 300000;  // several summary words
+
+    std::mt19937_64 rng( 7 );
+    std::uniform_int_distribution<size_t> slot( 0, kSlots - 1 );
+    OccupancyBitmap bitmap( kSlots );
+    std::set<size_t> expected;
+
+    for( size_t i = 0; i < 20000; ++i )
+    {
+        const size_t s = slot( rng );
+        if( rng() % 3 ) { bitmap.Set( s );   expected.insert( s ); }
+        else            { bitmap.Clear( s ); expected.erase( s );  }
+
+        const size_t probe = slot( rng );
+        auto next = expected.lower_bound( probe );
+        auto prev = expected.upper_bound( probe );
+        ASSERT_EQ( next == expected.end() ? OccupancyBitmap::kNone : *next, bitmap.NextSet( probe ) );
+        ASSERT_EQ( prev == expected.begin() ? OccupancyBitmap::kNone : *std::prev( prev ), bitmap.PrevSet( probe ) );
+    }
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include "OrderBookEngine.h"
+
+using Command = OrderBook::Command;
+
+TEST(OrderBookEngineTests, SymbolsAreProcessedOnTheirShards)
+{
+    UniqueIDGenerator id_gen;
+    OrderBookEngine engine( 2, id_gen, 1024, false );
+
+    const size_t goog = engine.AddSymbol( "GOOG" );
+    const size_t tsla = engine.AddSymbol( "TSLA", 0.1, 100.0, 300.0 );
+    ASSERT_EQ( 2, engine.GetShardCount() );
+    ASSERT_NE( engine.GetShard( goog ), engine.GetShard( tsla ) );
+
+    engine.Start();
+
+    ASSERT_TRUE( engine.Submit( goog, Command{ Command::Type::INSERT, OrderBook::Side::BUY,  1, 145.3,  17 } ) );
+    ASSERT_TRUE( engine.Submit( tsla, Command{ Command::Type::INSERT, OrderBook::Side::SELL, 2, 201.2, 121 } ) );
+    ASSERT_TRUE( engine.Submit( goog, Command{ Command::Type::INSERT, OrderBook::Side::SELL, 7, 146.2, 130 } ) );
+    ASSERT_TRUE( engine.Submit( goog, Command{ Command::Type::AMEND,  OrderBook::Side::BUY,  1, 147.0,  50 } ) );
+    ASSERT_TRUE( engine.Submit( tsla, Command{ Command::Type::INSERT, OrderBook::Side::BUY,  8, 209.8, 300 } ) );
+    ASSERT_TRUE( engine.Submit( tsla, Command{ Command::Type::INSERT, OrderBook::Side::BUY,  9, 999.0,   1 } ) );  // Outside of price band.
+
+    engine.Stop();
+
+    OrderBookEngine::Trade trade;
+    ASSERT_TRUE( engine.PollTrade( engine.GetShard( goog ), trade ) );
+    ASSERT_EQ( goog, trade.symbol );
+    ASSERT_EQ( 146.2, trade.trade.price );
+    ASSERT_EQ( 50, trade.trade.volume );
+    ASSERT_FALSE( engine.PollTrade( engine.GetShard( goog ), trade ) );
+
+    ASSERT_TRUE( engine.PollTrade( engine.GetShard( tsla ), trade ) );
+    ASSERT_EQ( tsla, trade.symbol );
+    ASSERT_EQ( OrderBook::ExecutedTrade( 201.2, 121, 8, 2, trade.trade.trade_id ), trade.trade );
+    ASSERT_FALSE( engine.PollTrade( engine.GetShard( tsla ), trade ) );
+    ASSERT_EQ( 1, engine.GetRejectedCount( engine.GetShard( tsla ) ) );
+    ASSERT_EQ( 0, engine.GetDroppedTradeCount( engine.GetShard( tsla ) ) );
+
+    std::vector<OrderBook::PriceLevel> levels { engine.GetBook( tsla ).GetPriceLevels() };
+    ASSERT_EQ( 1, levels.size() );
+    ASSERT_EQ( OrderBook::PriceLevel(209.8, 179, 0, 0), levels[0] );
+}
+
+
+TEST(OrderBookEngineTests, ManySymbolsAcrossShards)
+{
+    constexpr size_t kSymbols = 16;
+    constexpr size_t kOrders  = 2000;
+
+    UniqueIDGenerator id_gen;
+    OrderBookEngine engine( 4, id_gen, 256 );
+
+    for( size_t s = 0; s < kSymbols; ++s )
+    {
+        engine.AddSymbol( "SYM" + std::to_string(s), 0.01, 1.0, 100.0 );
+    }
+
+    engine.Start();
+
+    size_t traded_vol = 0;
+    auto poll_all = [&]
+    {
+        OrderBookEngine::Trade trade;
+        for( size_t shard = 0; shard < engine.GetShardCount(); ++shard )
+        {
+            while( engine.PollTrade( shard, trade ) ) { traded_vol += trade.trade.volume; }
+        }
+    };
+
+    for( size_t i = 0; i < kOrders; ++i )
+    {
+        for( size_t s = 0; s < kSymbols; ++s )
+        {
+            const Command command { Command::Type::INSERT, i % 2 ? OrderBook::Side::BUY : OrderBook::Side::SELL, i, 50.0, 3 };
+            while( !engine.Submit( s, command ) ) { poll_all(); }
+        }
+    }
+
+    engine.Stop();
+    poll_all();
+
+    ASSERT_EQ( kSymbols * kOrders / 2 * 3, traded_vol );
+}
+
+
+TEST(OrderBookEngineTests, TradesDroppedWhileStoppingAreCounted)
+{
+    constexpr size_t kCapacity = 16;
+    constexpr size_t kOrders   = kCapacity + 4;
+
+    UniqueIDGenerator id_gen;
+    OrderBookEngine engine( 1, id_gen, kCapacity, false );
+    const size_t goog = engine.AddSymbol( "GOOG" );
+    engine.Start();
+
+    for( size_t id = 1; id <= kOrders; ++id )
+    {
+        while( !engine.Submit( goog, Command{ Command::Type::INSERT, OrderBook::Side::SELL, id, 100.0, 1 } ) ) {}
+    }
+    while( !engine.Submit( goog, Command{ Command::Type::INSERT, OrderBook::Side::BUY, kOrders + 1, 100.0, kOrders } ) ) {}
+
+    // nobody polls, so the trades beyond the capacity of the trade queue are dropped
+    engine.Stop();
+
+    size_t polled = 0;
+    for( OrderBookEngine::Trade trade; engine.PollTrade( 0, trade ); ) { ++polled; }
+
+    ASSERT_EQ( kCapacity, polled );
+    ASSERT_EQ( kOrders - kCapacity, engine.GetDroppedTradeCount( 0 ) );
+    ASSERT_TRUE( engine.GetBook( goog ).GetPriceLevels().empty() );
+}
+
+
+TEST(OrderBookEngineTests, TradesPolledWhileStoppingAreNotDropped)
+{
+    constexpr size_t kCapacity = 16;
+    constexpr size_t kOrders   = 4 * kCapacity;
+
+    UniqueIDGenerator id_gen;
+    OrderBookEngine engine( 1, id_gen, kCapacity, false );
+    const size_t goog = engine.AddSymbol( "GOOG" );
+    engine.Start();
+
+    for( size_t id = 1; id <= kOrders; ++id )
+    {
+        while( !engine.Submit( goog, Command{ Command::Type::INSERT, OrderBook::Side::SELL, id, 100.0, 1 } ) ) {}
+    }
+    while( !engine.Submit( goog, Command{ Command::Type::INSERT, OrderBook::Side::BUY, kOrders + 1, 100.0, kOrders } ) ) {}
+
+    // the poller only starts draining the full trade queue after 'Stop()' was called
+    std::atomic<bool> stopped { false };
+    size_t polled = 0;
+    std::thread poller( [&]
+    {
+        std::this_thread::sleep_for( OrderBookEngine::kDrainTimeout / 5 );
+        for( OrderBookEngine::Trade trade; !stopped.load(); )
+        {
+            if( engine.PollTrade( 0, trade ) ) { ++polled; }
+        }
+    } );
+
+    engine.Stop();
+    stopped = true;
+    poller.join();
+
+    for( OrderBookEngine::Trade trade; engine.PollTrade( 0, trade ); ) { ++polled; }
+
+    ASSERT_EQ( kOrders, polled );
+    ASSERT_EQ( 0, engine.GetDroppedTradeCount( 0 ) );
+}
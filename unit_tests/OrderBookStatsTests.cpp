@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include "OrderBook.h"
+#include "OrderBookStats.h"
+
+TEST(OrderBookStatsTests, HistogramPercentiles)
+{
+    Histogram histogram;
+    ASSERT_EQ( 0, histogram.Percentile( 50.0 ) );
+
+    for( uint64_t value = 1; value <= 1000; ++value )
+    {
+        histogram.Record( value );
+    }
+
+    ASSERT_EQ( 1000, histogram.Count() );
+    ASSERT_EQ( 500500, histogram.Sum() );
+    ASSERT_EQ( 1000, histogram.Max() );
+
+    // values are exact below 'kSubBuckets', above within 1/kSubBuckets of the real value
+    const double tolerance = 1.0 / Histogram::kSubBuckets;
+    ASSERT_NEAR( 500.0, double( histogram.Percentile( 50.0 ) ), 500.0 * tolerance );
+    ASSERT_NEAR( 990.0, double( histogram.Percentile( 99.0 ) ), 990.0 * tolerance );
+    ASSERT_EQ( 1000, histogram.Percentile( 100.0 ) );
+    ASSERT_EQ( 1, histogram.Percentile( 0.0 ) );
+
+    histogram.Record( uint64_t(1) << 60 );  // beyond 'kMaxValueBits'
+    ASSERT_EQ( uint64_t(1) << 60, histogram.Percentile( 100.0 ) );
+}
+
+
+TEST(OrderBookStatsTests, Counters)
+{
+    OrderBookStats stats;
+
+    {
+        const auto timer = stats.Time( StatsOp::INSERT );
+    }
+    stats.OnSweep( 0, 0 );   // no fills, not an aggressive order
+    stats.OnSweep( 3, 2 );
+    stats.OnSweep( 1, 1 );
+    stats.OnLevelCreated();
+    stats.OnLevelCreated();
+    stats.OnLevelErased();
+    stats.OnPoolGrowth();
+
+    const OrderBookStatsSnapshot snapshot = stats.Snapshot();
+    ASSERT_EQ( 1, snapshot.latency[ size_t(StatsOp::INSERT) ].count );
+    ASSERT_EQ( 0, snapshot.latency[ size_t(StatsOp::PULL) ].count );
+    ASSERT_LE( snapshot.latency[ size_t(StatsOp::INSERT) ].p50_ns, snapshot.latency[ size_t(StatsOp::INSERT) ].max_ns );
+    ASSERT_EQ( 2, snapshot.aggressive_orders );
+    ASSERT_EQ( 4, snapshot.fills );
+    ASSERT_EQ( 3, snapshot.max_fills_per_aggressor );
+    ASSERT_EQ( 3, snapshot.levels_crossed );
+    ASSERT_EQ( 2, snapshot.max_levels_per_sweep );
+    ASSERT_EQ( 2, snapshot.level_creations );
+    ASSERT_EQ( 1, snapshot.level_erasures );
+    ASSERT_EQ( 1, snapshot.pool_growths );
+}
+
+
+#ifdef ORDERBOOK_ENABLE_STATS
+TEST(OrderBookStatsTests, OrderBookRecordsStats)
+{
+    UniqueIDGenerator id_gen;
+    OrderBook book( "GOOG", id_gen );
+
+    book.Insert( 1, OrderBook::Side::SELL, 100.0, 10 );
+    book.Insert( 2, OrderBook::Side::SELL, 100.0, 10 );
+    book.Insert( 3, OrderBook::Side::SELL, 101.0, 10 );
+    book.Insert( 4, OrderBook::Side::BUY,  101.0, 25 );  // sweeps both sell levels
+    book.Pull( 3 );
+    book.GetPriceLevels();
+
+    const OrderBookStatsSnapshot stats = book.GetStats();
+    ASSERT_EQ( 4, stats.latency[ size_t(StatsOp::INSERT) ].count );
+    ASSERT_EQ( 1, stats.latency[ size_t(StatsOp::PULL) ].count );
+    ASSERT_EQ( 1, stats.latency[ size_t(StatsOp::GET_PRICE_LEVELS) ].count );
+    ASSERT_EQ( 1, stats.aggressive_orders );
+    ASSERT_EQ( 3, stats.fills );
+    ASSERT_EQ( 2, stats.levels_crossed );
+    ASSERT_EQ( 3, stats.level_creations );
+    ASSERT_EQ( 3, stats.level_erasures );
+}
+#endif
@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory_resource>
+#include <random>
+
 #include "OrderBook.h"
+#include "OrderBookImpl.h"
 #include "UniqueIDGenerator.h"
 
 TEST(OrderBookTests, SimpleInsert)
@@ -164,7 +172,7 @@ TEST(OrderBookTests, InsertAndAmend)
     msft.Insert(  5, OrderBook::Side::SELL,   45.95,  1 );
     msft.Amend (  1,                          45.95,  1 );
     msft.Insert(  6, OrderBook::Side::SELL,   45.95,  1 );
-    msft.Amend (  1,                          45.95,  5 );
+    msft.Amend (  1,                          45.95,  5 );  // Order '1' has been fully matched, so this is ignored.
     msft.Insert(  7, OrderBook::Side::SELL,   45.95,  1 );
 
     // check trades
@@ -179,7 +187,7 @@ TEST(OrderBookTests, InsertAndAmend)
     // check price levels
     std::vector<OrderBook::PriceLevel> levels { msft.GetPriceLevels() };
     ASSERT_EQ( 1, levels.size() );
-    ASSERT_EQ( OrderBook::PriceLevel(45.95,16,  46,5), levels[0] );
+    ASSERT_EQ( OrderBook::PriceLevel(45.95,11,  46,5), levels[0] );
 
 }
 
@@ -228,4 +236,1006 @@ TEST(OrderBookTests, TradeCorrectlyLoosesPricePriority)
     std::vector<OrderBook::PriceLevel> tslaLevels { tsla.GetPriceLevels() };
     ASSERT_EQ( 1, tslaLevels.size() );
     ASSERT_EQ( OrderBook::PriceLevel(0,0, 205.5, 100), tslaLevels[0] );
-}
\ No newline at end of file
+}
+
+TEST(OrderBookTests, TickLadderMatchesAcrossLevels)
+{
+    UniqueIDGenerator id_gen;
+    OrderBook book("MSFT", id_gen, 0.001, 10.0, 20.0);
+
+    /*
+    sym,  op,   id,     buy/sell side,     price,  vol */
+    book.Insert(8, OrderBook::Side::BUY,  14.235,  5 );
+    book.Insert(6, OrderBook::Side::BUY,  14.235,  6 );
+    book.Insert(7, OrderBook::Side::BUY,  14.235, 12 );
+    book.Insert(2, OrderBook::Side::BUY,  14.234,  5 );
+    book.Insert(1, OrderBook::Side::BUY,  14.23,   3 );
+    book.Insert(5, OrderBook::Side::SELL, 14.237,  8 );
+    book.Insert(3, OrderBook::Side::SELL, 14.24,   9 );
+    book.Pull(8);
+    book.Insert(4, OrderBook::Side::SELL, 14.234, 25 );
+
+    // check trades
+    std::vector< OrderBook::ExecutedTrade > trades = book.GetListOfTrades();
+    ASSERT_EQ( 3, trades.size() );
+    ASSERT_EQ( OrderBook::ExecutedTrade(14.235,  6, 4, 6, 0), trades[0] );
+    ASSERT_EQ( OrderBook::ExecutedTrade(14.235, 12, 4, 7, 1), trades[1] );
+    ASSERT_EQ( OrderBook::ExecutedTrade(14.234,  5, 4, 2, 2), trades[2] );
+
+    // check price levels
+    std::vector<OrderBook::PriceLevel> levels { book.GetPriceLevels() };
+    ASSERT_EQ( 3, levels.size() );
+    ASSERT_EQ( OrderBook::PriceLevel(14.23, 3, 14.234, 2), levels[0] );
+    ASSERT_EQ( OrderBook::PriceLevel(    0, 0, 14.237, 8), levels[1] );
+    ASSERT_EQ( OrderBook::PriceLevel(    0, 0, 14.24,  9), levels[2] );
+}
+
+
+TEST(OrderBookTests, TickLadderRejectsPricesOffTickAndOutsideBand)
+{
+    UniqueIDGenerator id_gen;
+    OrderBook book("MSFT", id_gen, 0.05, 100.0, 200.0);
+
+    book.Insert( 1, OrderBook::Side::BUY, 150.05, 5 );
+    book.Insert( 2, OrderBook::Side::BUY, 150.00 + 0.05, 7 );  // same level as order '1' despite the rounding error
+
+    ASSERT_THROW( book.Insert( 3, OrderBook::Side::BUY, 150.049, 1 ), std::invalid_argument );  // not snapped to 150.05
+    ASSERT_THROW( book.Amend ( 1, 150.03, 5 ),                       std::invalid_argument );
+
+    std::vector<OrderBook::PriceLevel> levels { book.GetPriceLevels() };
+    ASSERT_EQ( 1, levels.size() );
+    ASSERT_EQ( OrderBook::PriceLevel(150.05, 12, 0, 0), levels[0] );
+
+    ASSERT_THROW( book.Insert( 3, OrderBook::Side::SELL, 200.1, 1 ), std::out_of_range );
+    ASSERT_THROW( book.Amend ( 1, 99.9, 5 ),                        std::out_of_range );
+    ASSERT_THROW( OrderBook("BAD", id_gen, 0.0, 1.0, 2.0),           std::invalid_argument );
+}
+
+
+TEST(OrderBookTests, AmendUsesVolumeRemainingAfterPartialMatch)
+{
+    UniqueIDGenerator id_gen;
+    OrderBook book("MSFT", id_gen);
+
+    /*
+    sym,  op,   id,     buy/sell side,     price,  vol */
+    book.Insert( 1, OrderBook::Side::BUY,  10.0,   10 );
+    book.Insert( 2, OrderBook::Side::SELL, 10.0,    4 );  // Leaves order '1' with a volume of 6.
+    book.Insert( 3, OrderBook::Side::BUY,  10.0,    5 );
+    book.Amend ( 1,                        10.0,    8 );  // Volume increase from 6 to 8, order '1' looses time priority to order '3'.
+    book.Insert( 4, OrderBook::Side::SELL, 10.0,    5 );
+    book.Pull  ( 2 );                                     // Fully matched, nothing to pull.
+
+    std::vector< OrderBook::ExecutedTrade > trades = book.GetListOfTrades();
+    ASSERT_EQ( 2, trades.size() );
+    ASSERT_EQ( OrderBook::ExecutedTrade(10.0, 4, 2, 1, 0), trades[0] );
+    ASSERT_EQ( OrderBook::ExecutedTrade(10.0, 5, 4, 3, 1), trades[1] );
+
+    std::vector<OrderBook::PriceLevel> levels { book.GetPriceLevels() };
+    ASSERT_EQ( 1, levels.size() );
+    ASSERT_EQ( OrderBook::PriceLevel(10.0, 8, 0, 0), levels[0] );
+}
+
+
+TEST(OrderBookTests, TopOfBookAndDepth)
+{
+    UniqueIDGenerator id_gen;
+    OrderBook book("MSFT", id_gen, 0.01, 1.0, 100.0);
+
+    ASSERT_EQ( OrderBook::PriceLevel(0, 0, 0, 0), book.GetTopOfBook() );
+
+    /*
+    sym,  op,   id,     buy/sell side,     price,  vol */
+    book.Insert( 1, OrderBook::Side::BUY,  10.00,  5 );
+    book.Insert( 2, OrderBook::Side::BUY,  10.00,  7 );
+    book.Insert( 3, OrderBook::Side::BUY,   9.50,  4 );
+    book.Insert( 4, OrderBook::Side::BUY,   9.00,  1 );
+    book.Insert( 5, OrderBook::Side::SELL, 10.50,  3 );
+    book.Insert( 6, OrderBook::Side::SELL, 11.00,  8 );
+    book.Amend ( 2,                        10.00,  6 );
+    book.Pull  ( 6 );
+    book.Insert( 7, OrderBook::Side::SELL, 10.00,  2 );  // Partially matches order '1'.
+
+    ASSERT_EQ( OrderBook::PriceLevel(10.00, 9, 10.50, 3), book.GetTopOfBook() );
+
+    OrderBook::PriceLevel depth[5];
+    ASSERT_EQ( 2, book.GetDepth( 2, depth ) );
+    ASSERT_EQ( OrderBook::PriceLevel(10.00, 9, 10.50, 3), depth[0] );
+    ASSERT_EQ( OrderBook::PriceLevel( 9.50, 4,     0, 0), depth[1] );
+
+    ASSERT_EQ( 3, book.GetDepth( 10, depth ) );
+    ASSERT_EQ( OrderBook::PriceLevel( 9.00, 1,     0, 0), depth[2] );
+
+    std::vector<OrderBook::PriceLevel> levels { book.GetPriceLevels() };
+    ASSERT_EQ( 3, levels.size() );
+    ASSERT_TRUE( std::equal( levels.begin(), levels.end(), depth ) );
+}
+
+
+TEST(OrderBookTests, LevelDeltasAreCoalescedPerOperation)
+{
+    UniqueIDGenerator id_gen;
+    OrderBook book("MSFT", id_gen);
+
+    std::vector< OrderBook::LevelDelta > deltas;
+    book.SetDeltaSink( [&deltas]( const OrderBook::LevelDelta& delta ) { deltas.push_back( delta ); } );
+
+    /*
+    sym,  op,   id,     buy/sell side,     price,  vol */
+    book.Insert( 1, OrderBook::Side::SELL, 10.1,   2 );
+    book.Insert( 2, OrderBook::Side::SELL, 10.1,   3 );
+    book.Insert( 3, OrderBook::Side::SELL, 10.2,   4 );
+    book.Insert( 4, OrderBook::Side::SELL, 10.3,   5 );
+    book.Insert( 5, OrderBook::Side::BUY,   9.9,   1 );
+    ASSERT_EQ( 5, deltas.size() );
+    ASSERT_EQ( OrderBook::LevelDelta(2, OrderBook::Side::SELL, 10.1, 5, 2), deltas[1] );
+    deltas.clear();
+
+    book.Insert( 6, OrderBook::Side::BUY,  10.3,  10 );  // Sweeps through three sell levels with four fills.
+    ASSERT_EQ( 4, deltas.size() );
+    ASSERT_EQ( OrderBook::LevelDelta( 6, OrderBook::Side::BUY,  10.3, 0, 0), deltas[0] );
+    ASSERT_EQ( OrderBook::LevelDelta( 7, OrderBook::Side::SELL, 10.1, 0, 0), deltas[1] );
+    ASSERT_EQ( OrderBook::LevelDelta( 8, OrderBook::Side::SELL, 10.2, 0, 0), deltas[2] );
+    ASSERT_EQ( OrderBook::LevelDelta( 9, OrderBook::Side::SELL, 10.3, 4, 1), deltas[3] );
+    deltas.clear();
+
+    book.Amend( 5, 9.8, 1 );
+    book.Pull ( 4 );
+    book.Pull ( 4 );  // Unknown order, no delta.
+    ASSERT_EQ( 3, deltas.size() );
+    ASSERT_EQ( OrderBook::LevelDelta(10, OrderBook::Side::BUY,   9.9, 0, 0), deltas[0] );
+    ASSERT_EQ( OrderBook::LevelDelta(11, OrderBook::Side::BUY,   9.8, 1, 1), deltas[1] );
+    ASSERT_EQ( OrderBook::LevelDelta(12, OrderBook::Side::SELL, 10.3, 0, 0), deltas[2] );
+}
+
+
+TEST(OrderBookTests, SnapshotRestoresRestingOrdersAndPriority)
+{
+    const std::string path = ( std::filesystem::temp_directory_path() / "OrderBookTests_Snapshot.snap" ).string();
+
+    UniqueIDGenerator id_gen;
+    OrderBook book("MSFT", id_gen, 0.01, 1.0, 100.0);
+
+    /*
+    sym,  op,   id,     buy/sell side,     price,  vol */
+    book.Insert( 1, OrderBook::Side::BUY,  10.00,  5 );
+    book.Insert( 2, OrderBook::Side::BUY,  10.00,  7 );
+    book.Insert( 3, OrderBook::Side::BUY,   9.50,  4 );
+    book.Insert( 4, OrderBook::Side::SELL, 10.50,  3 );
+    book.Insert( 5, OrderBook::Side::SELL, 10.00,  2 );  // Partially matches order '1'.
+    book.Amend ( 1,                        10.00,  6 );  // Order '1' looses time priority to order '2'.
+    book.SaveSnapshot( path );
+
+    UniqueIDGenerator restored_id_gen;
+    OrderBook restored("MSFT", restored_id_gen, 0.01, 1.0, 100.0);
+    restored.LoadSnapshot( path );
+    std::filesystem::remove( path );
+
+    ASSERT_EQ( book.GetPriceLevels(), restored.GetPriceLevels() );
+    ASSERT_THROW( restored.LoadSnapshot( path ), std::logic_error );  // Order book is not empty anymore.
+
+    restored.Insert( 6, OrderBook::Side::SELL, 10.00, 13 );
+    restored.Insert( 7, OrderBook::Side::BUY,   9.50,  1 );  // Behind order '3' at the same price.
+    restored.Insert( 8, OrderBook::Side::SELL,  9.50,  4 );
+
+    std::vector< OrderBook::ExecutedTrade > trades = restored.GetListOfTrades();
+    ASSERT_EQ( 3, trades.size() );
+    ASSERT_EQ( OrderBook::ExecutedTrade(10.00, 7, 6, 2, 1), trades[0] );
+    ASSERT_EQ( OrderBook::ExecutedTrade(10.00, 6, 6, 1, 2), trades[1] );
+    ASSERT_EQ( OrderBook::ExecutedTrade( 9.50, 4, 8, 3, 3), trades[2] );
+
+    ASSERT_EQ( OrderBook::PriceLevel( 9.50, 1, 10.50, 3), restored.GetTopOfBook() );
+}
+
+
+TEST(OrderBookTests, SnapshotRestoresAuction)
+{
+    const std::string path = ( std::filesystem::temp_directory_path() / "OrderBookTests_Auction.snap" ).string();
+
+    UniqueIDGenerator id_gen;
+    OrderBook book("MSFT", id_gen, 0.01, 1.0, 100.0);
+    book.StartAuction();
+    book.Insert( 1, OrderBook::Side::BUY,  10.10, 5 );
+    book.Insert( 2, OrderBook::Side::SELL,  9.90, 3 );  // Crosses the book, but does not match during the auction.
+    book.SaveSnapshot( path );
+
+    UniqueIDGenerator restored_id_gen;
+    OrderBook restored("MSFT", restored_id_gen, 0.01, 1.0, 100.0);
+    restored.LoadSnapshot( path );
+    std::filesystem::remove( path );
+
+    ASSERT_TRUE( restored.InAuction() );
+    ASSERT_EQ( book.GetPriceLevels(), restored.GetPriceLevels() );
+
+    restored.Insert( 3, OrderBook::Side::BUY, 9.80, 1 );
+    ASSERT_TRUE( restored.GetListOfTrades().empty() );
+
+    ASSERT_EQ( book.Uncross().volume, restored.Uncross().volume );
+    ASSERT_FALSE( restored.InAuction() );
+    ASSERT_EQ( 1, restored.GetListOfTrades().size() );
+}
+
+
+TEST(OrderBookTests, SnapshotRejectsCorruptRecords)
+{
+    const std::string path = ( std::filesystem::temp_directory_path() / "OrderBookTests_Corrupt.snap" ).string();
+
+    UniqueIDGenerator id_gen;
+    OrderBook book("MSFT", id_gen, 0.01, 1.0, 100.0);
+    book.Insert( 1, OrderBook::Side::BUY,  10.00,  5 );
+    book.Insert( 2, OrderBook::Side::SELL, 10.50,  3 );
+    book.Insert( 3, OrderBook::Side::BUY,  10.00,  2 );
+    book.SaveSnapshot( path );
+
+    std::string saved;
+    {
+        std::ifstream in( path, std::ios::binary );
+        saved.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+    }
+    ASSERT_EQ( 72 + 3 * 40, saved.size() );  // header followed by one record per order, buy orders first
+
+    // writes 'value' at 'offset' of a copy of the snapshot and loads it into an empty order book
+    auto load_patched = [&]( const size_t offset, const uint64_t value )
+    {
+        std::string patched = saved;
+        std::memcpy( patched.data() + offset, &value, sizeof(value) );
+        std::ofstream( path, std::ios::binary | std::ios::trunc ).write( patched.data(), std::streamsize( patched.size() ) );
+
+        UniqueIDGenerator restored_id_gen;
+        OrderBook restored("MSFT", restored_id_gen, 0.01, 1.0, 100.0);
+        try
+        {
+            restored.LoadSnapshot( path );
+        }
+        catch( ... )
+        {
+            EXPECT_TRUE( restored.GetPriceLevels().empty() );
+            throw;
+        }
+    };
+
+    ASSERT_NO_THROW( load_patched( 72, 1 ) );                                 // unchanged
+    ASSERT_THROW( load_patched( 72 + 40,      1 ), std::invalid_argument );  // second order gets the id of the first
+    ASSERT_THROW( load_patched( 72 + 40 + 24, 0 ), std::out_of_range );      // second order has no volume
+    ASSERT_THROW( load_patched( 72 + 8,       3 ), std::invalid_argument );  // first order has the next time priority to hand out
+    ASSERT_THROW( load_patched( 72 + 8,       2 ), std::invalid_argument );  // first order is not ahead of the second in their level
+    ASSERT_THROW( load_patched( 64,           2 ), std::invalid_argument );  // unknown flag
+
+    ASSERT_THROW( load_patched( 48, ( uint64_t(1) << 61 ) + 2 ), std::invalid_argument );  // buy order count whose size in bytes wraps around
+
+    std::filesystem::remove( path );
+}
+
+
+TEST(OrderBookTests, ApplyBatchMatchesSequentialApply)
+{
+    using Command = OrderBook::Command;
+
+    // crossing inserts, amends and pulls of orders which may have been matched earlier in the batch
+    std::vector<Command> commands;
+    uint64_t state = 12345;
+    auto next = [&state]( const uint64_t n ) { state = state * 6364136223846793005ull + 1442695040888963407ull; return ( state >> 33 ) % n; };
+
+    for( size_t id = 1; commands.size() < 2000; )
+    {
+        const uint64_t kind = next( 10 );
+        if( kind < 5 || id < 10 )
+        {
+            const OrderBook::Side side = next( 2 ) ? OrderBook::Side::BUY : OrderBook::Side::SELL;
+            commands.push_back( Command{ Command::Type::INSERT, side, id++, 90.0 + double( next( 20 ) ), 1 + next( 50 ) } );
+        }
+        else if( kind < 8 )
+        {
+            commands.push_back( Command{ Command::Type::AMEND, OrderBook::Side::BUY, 1 + next( id - 1 ), 90.0 + double( next( 20 ) ), 1 + next( 50 ) } );
+        }
+        else
+        {
+            commands.push_back( Command{ Command::Type::PULL, OrderBook::Side::BUY, 1 + next( id - 1 ), 0.0, 0 } );
+        }
+    }
+
+    for( const bool dense : { false, true } )
+    {
+        UniqueIDGenerator sequential_id_gen;
+        UniqueIDGenerator batch_id_gen;
+        OrderBook sequential = dense ? OrderBook( "GOOG", sequential_id_gen, 1.0, 50.0, 150.0 ) : OrderBook( "GOOG", sequential_id_gen );
+        OrderBook batch      = dense ? OrderBook( "GOOG", batch_id_gen,      1.0, 50.0, 150.0 ) : OrderBook( "GOOG", batch_id_gen );
+
+        std::vector< OrderBook::LevelDelta > sequential_deltas;
+        std::vector< OrderBook::LevelDelta > batch_deltas;
+        sequential.SetDeltaSink( [&]( const OrderBook::LevelDelta& delta ) { sequential_deltas.push_back( delta ); } );
+        batch.SetDeltaSink     ( [&]( const OrderBook::LevelDelta& delta ) { batch_deltas.push_back( delta ); } );
+
+        for( const Command& command : commands )
+        {
+            sequential.Apply( command );
+        }
+
+        // batches of varying size
+        for( size_t begin = 0, size = 1; begin < commands.size(); begin += size, size = size * 2 % 97 )
+        {
+            batch.ApplyBatch( std::span<const Command>( commands ).subspan( begin, std::min( size, commands.size() - begin ) ) );
+        }
+
+        ASSERT_FALSE( sequential.GetListOfTrades().empty() );
+        ASSERT_EQ( sequential.GetListOfTrades(), batch.GetListOfTrades() );
+        ASSERT_EQ( sequential.GetPriceLevels(), batch.GetPriceLevels() );
+        ASSERT_EQ( sequential_deltas, batch_deltas );
+    }
+}
+
+
+TEST(OrderBookTests, AuctionUncrossesAtSingleClearingPrice)
+{
+    UniqueIDGenerator id_gen;
+    OrderBook book("AAPL", id_gen, 0.1, 1.0, 100.0);
+
+    book.StartAuction();
+    ASSERT_TRUE( book.InAuction() );
+
+    /*
+    sym,  op,   id,     buy/sell side,     price,  vol */
+    book.Insert( 1, OrderBook::Side::SELL, 10.0,  5 );
+    book.Insert( 2, OrderBook::Side::SELL, 10.1,  5 );
+    book.Insert( 3, OrderBook::Side::SELL, 10.2, 10 );
+    book.Insert( 4, OrderBook::Side::BUY,  10.2,  4 );
+    book.Insert( 5, OrderBook::Side::BUY,  10.1,  6 );
+    book.Insert( 6, OrderBook::Side::BUY,  10.0,  3 );
+    book.Amend ( 6,                        10.0,  5 );
+    ASSERT_TRUE( book.GetListOfTrades().empty() );
+
+    // 10.0: 15 bid, 5 offered. 10.1: 10 bid, 10 offered. 10.2: 4 bid, 20 offered.
+    const OrderBook::AuctionResult indicative = book.GetIndicativeUncross();
+    ASSERT_EQ( OrderBook::AuctionResult( 10.1, 10, 0 ), indicative );
+
+    ASSERT_EQ( indicative, book.Uncross() );
+    ASSERT_FALSE( book.InAuction() );
+
+    std::vector< OrderBook::ExecutedTrade > trades = book.GetListOfTrades();
+    ASSERT_EQ( 3, trades.size() );
+    ASSERT_EQ( OrderBook::ExecutedTrade(10.1, 4, 4, 1, 0), trades[0] );
+    ASSERT_EQ( OrderBook::ExecutedTrade(10.1, 1, 5, 1, 1), trades[1] );
+    ASSERT_EQ( OrderBook::ExecutedTrade(10.1, 5, 5, 2, 2), trades[2] );
+    ASSERT_EQ( OrderBook::PriceLevel(10.0, 5, 10.2, 10), book.GetTopOfBook() );
+    ASSERT_EQ( OrderBook::AuctionResult( 0.0, 0, 0 ), book.GetIndicativeUncross() );
+
+    // continuous trading again
+    book.Insert( 7, OrderBook::Side::SELL, 10.0, 2 );
+    ASSERT_EQ( 4, book.GetListOfTrades().size() );
+    ASSERT_EQ( OrderBook::ExecutedTrade(10.0, 2, 7, 6, 3), book.GetListOfTrades().back() );
+}
+
+
+namespace
+{
+    /**
+     * @brief Memory resource which keeps track of the number of bytes allocated from it.
+     */
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        size_t outstanding = 0;
+
+    private:
+        void* do_allocate( const size_t bytes, const size_t alignment ) override
+        {
+            outstanding += bytes;
+            return std::pmr::new_delete_resource()->allocate( bytes, alignment );
+        }
+
+        void do_deallocate( void* p, const size_t bytes, const size_t alignment ) override
+        {
+            outstanding -= bytes;
+            std::pmr::new_delete_resource()->deallocate( p, bytes, alignment );
+        }
+
+        bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+}
+
+
+TEST(OrderBookTests, ResetReleasesArena)
+{
+    CountingResource resource;
+    UniqueIDGenerator id_gen;
+    OrderBook book("GOOG", id_gen, &resource);
+
+    std::vector< OrderBook::LevelDelta > deltas;
+    book.SetDeltaSink( [&]( const OrderBook::LevelDelta& delta ) { deltas.push_back( delta ); } );
+
+    for( size_t id = 1; id <= 1000; ++id )
+    {
+        book.Insert( id, id % 2 ? OrderBook::Side::BUY : OrderBook::Side::SELL, id % 2 ? 100.0 - double(id % 7) : 101.0 + double(id % 5), 10 );
+    }
+    ASSERT_GT( resource.outstanding, 1000 * sizeof(size_t) );
+
+    deltas.clear();
+    book.Reset();
+    ASSERT_EQ( 0, resource.outstanding );
+    ASSERT_EQ( 7 + 5, deltas.size() );
+    ASSERT_EQ( 0, deltas.front().vol );
+    ASSERT_EQ( OrderBook::PriceLevel(), book.GetTopOfBook() );
+
+    // the order book starts over, order ids may be reused
+    book.Insert( 1, OrderBook::Side::SELL, 101.0, 10 );
+    book.Insert( 2, OrderBook::Side::BUY,  101.0,  4 );
+    ASSERT_EQ( 1, book.GetListOfTrades().size() );
+    ASSERT_EQ( OrderBook::PriceLevel(0.0, 0, 101.0, 6), book.GetTopOfBook() );
+}
+
+
+TEST(OrderBookTests, MassCancelByOwnerRangeAndSide)
+{
+    using Side = OrderBook::Side;
+
+    for( const bool dense : { false, true } )
+    {
+        UniqueIDGenerator id_gen;
+        OrderBook book = dense ? OrderBook( "GOOG", id_gen, 1.0, 50.0, 150.0 ) : OrderBook( "GOOG", id_gen );
+
+        std::vector< OrderBook::LevelDelta > deltas;
+        book.SetDeltaSink( [&deltas]( const OrderBook::LevelDelta& delta ) { deltas.push_back( delta ); } );
+
+        /*
+        sym,  op,   id,  buy/sell side,  price,  vol, owner */
+        book.Insert( 1, Side::BUY,   99,  10,   7 );
+        book.Insert( 2, Side::BUY,   99,   5,   8 );
+        book.Insert( 3, Side::BUY,   98,   4,   7 );
+        book.Insert( 4, Side::SELL, 101,   3,   7 );
+        book.Insert( 5, Side::SELL, 102,   6,   8 );
+        book.Insert( 6, Side::SELL, 103,   2,   8 );
+        book.Insert( 7, Side::SELL, 104,   1 );
+        deltas.clear();
+
+        ASSERT_EQ( 3, book.CancelOwner( 7 ) );
+        ASSERT_EQ( 3, deltas.size() );
+        ASSERT_EQ( OrderBook::LevelDelta( 8, Side::BUY,   99, 5, 1 ), deltas[0] );
+        ASSERT_EQ( OrderBook::LevelDelta( 9, Side::BUY,   98, 0, 0 ), deltas[1] );
+        ASSERT_EQ( OrderBook::LevelDelta(10, Side::SELL, 101, 0, 0 ), deltas[2] );
+        ASSERT_EQ( OrderBook::PriceLevel( 99, 5, 102, 6 ), book.GetTopOfBook() );
+        book.Pull( 1 );  // already cancelled, no delta
+        ASSERT_EQ( 3, deltas.size() );
+        deltas.clear();
+
+        ASSERT_EQ( 2, book.CancelPriceRange( Side::SELL, 102.5, 1000.0 ) );
+        ASSERT_EQ( 2, deltas.size() );
+        ASSERT_EQ( OrderBook::LevelDelta(11, Side::SELL, 103, 0, 0 ), deltas[0] );
+        ASSERT_EQ( OrderBook::LevelDelta(12, Side::SELL, 104, 0, 0 ), deltas[1] );
+        ASSERT_EQ( 1, book.GetPriceLevels().size() );
+
+        ASSERT_EQ( 1, book.CancelSide( Side::BUY ) );
+        ASSERT_EQ( 0, book.CancelSide( Side::BUY ) );
+        ASSERT_EQ( OrderBook::PriceLevel( 0, 0, 102, 6 ), book.GetTopOfBook() );
+
+        // dropped levels can be used again
+        book.Insert( 8, Side::BUY,  99, 1 );
+        book.Insert( 9, Side::BUY, 102, 6 );
+        ASSERT_EQ( 1, book.GetListOfTrades().size() );
+        ASSERT_EQ( 5, book.GetListOfTrades()[0].passive_order_id );
+        ASSERT_EQ( OrderBook::PriceLevel( 99, 1, 0, 0 ), book.GetTopOfBook() );
+
+        // 'kAnyOwner' removes the orders of every owner
+        book.Insert( 10, Side::SELL, 105, 2, 8 );
+        ASSERT_EQ( 2, book.CancelOwner( OrderBook::kAnyOwner ) );
+        ASSERT_TRUE( book.GetPriceLevels().empty() );
+    }
+}
+
+
+TEST(OrderBookTests, RepriceMovesOrdersAndMatchesOnce)
+{
+    using Side = OrderBook::Side;
+
+    for( const bool dense : { false, true } )
+    {
+        UniqueIDGenerator id_gen;
+        OrderBook book = dense ? OrderBook( "GOOG", id_gen, 1.0, 50.0, 150.0 ) : OrderBook( "GOOG", id_gen );
+        const std::int64_t one = dense ? 1 : 100000000;  // ticks per price unit
+
+        /*
+        sym,  op,   id,  buy/sell side,  price,  vol, owner */
+        book.Insert( 1, Side::SELL, 101,   5,   7 );
+        book.Insert( 2, Side::SELL, 101,   5,   8 );
+        book.Insert( 3, Side::SELL, 102,   5,   7 );
+        book.Insert( 4, Side::BUY,   99,   5,   7 );
+        book.Insert( 5, Side::BUY,   98,   5 );
+
+        ASSERT_EQ( 0, book.Reprice( Side::SELL, 0, 7 ) );
+        ASSERT_EQ( 2, book.Reprice( Side::SELL, -one, 7 ) );
+        ASSERT_EQ( OrderBook::PriceLevel( 99, 5, 100, 5 ), book.GetTopOfBook() );
+
+        // the whole buy side moves up before the crossed book is matched
+        ASSERT_EQ( 2, book.Reprice( Side::BUY, one ) );
+        ASSERT_EQ( 1, book.GetListOfTrades().size() );
+        ASSERT_EQ( OrderBook::ExecutedTrade( 100, 5, 4, 1, 0 ), book.GetListOfTrades()[0] );
+        ASSERT_EQ( OrderBook::PriceLevel( 99, 5, 101, 10 ), book.GetTopOfBook() );
+
+        // order 3 moved to 101 behind order 2
+        book.Insert( 6, Side::BUY, 101, 5 );
+        ASSERT_EQ( 2, book.GetListOfTrades()[1].passive_order_id );
+
+        if( dense )
+        {
+            ASSERT_THROW( book.Reprice( Side::SELL, 100 ), std::out_of_range );
+            ASSERT_EQ( OrderBook::PriceLevel( 99, 5, 101, 5 ), book.GetTopOfBook() );
+        }
+
+        // a shift overflowing the tick type is rejected like one leaving the price band
+        ASSERT_THROW( book.Reprice( Side::SELL, std::numeric_limits<std::int64_t>::max() ), std::out_of_range );
+        ASSERT_THROW( book.Reprice( Side::BUY,  std::numeric_limits<std::int64_t>::max() ), std::out_of_range );
+        ASSERT_EQ( OrderBook::PriceLevel( 99, 5, 101, 5 ), book.GetTopOfBook() );
+    }
+}
+
+
+TEST(OrderBookTests, CrossingRepricePublishesEachLevelOnce)
+{
+    using Side  = OrderBook::Side;
+    using Delta = OrderBook::LevelDelta;
+
+    for( const bool dense : { false, true } )
+    {
+        UniqueIDGenerator id_gen;
+        OrderBook book = dense ? OrderBook( "GOOG", id_gen, 1.0, 50.0, 150.0 ) : OrderBook( "GOOG", id_gen );
+        const std::int64_t one = dense ? 1 : 100000000;  // ticks per price unit
+
+        book.Insert( 1, Side::BUY,   98, 5 );
+        book.Insert( 2, Side::SELL, 100, 5 );
+        book.Insert( 3, Side::SELL, 101, 5 );
+
+        std::vector< Delta > deltas;
+        book.SetDeltaSink( [&deltas]( const Delta& delta ) { deltas.push_back( delta ); } );
+
+        // order 2 lands on the bid and trades, touching its new level a second time
+        ASSERT_EQ( 2, book.Reprice( Side::SELL, -2 * one ) );
+        ASSERT_EQ( 1, book.GetListOfTrades().size() );
+
+        ASSERT_EQ( 5, deltas.size() );
+        ASSERT_EQ( Delta( 1, Side::SELL,  98, 0, 0 ), deltas[0] );
+        ASSERT_EQ( Delta( 2, Side::SELL,  99, 5, 1 ), deltas[1] );
+        ASSERT_EQ( Delta( 3, Side::SELL, 100, 0, 0 ), deltas[2] );
+        ASSERT_EQ( Delta( 4, Side::SELL, 101, 0, 0 ), deltas[3] );
+        ASSERT_EQ( Delta( 5, Side::BUY,   98, 0, 0 ), deltas[4] );
+    }
+}
+
+TEST(OrderBookTests, ImmediateOrdersNeverRest)
+{
+    using Side = OrderBook::Side;
+    using TIF  = OrderBook::TimeInForce;
+
+    for( const bool dense : { false, true } )
+    {
+        UniqueIDGenerator id_gen;
+        OrderBook book = dense ? OrderBook( "GOOG", id_gen, 1.0, 50.0, 150.0 ) : OrderBook( "GOOG", id_gen );
+
+        std::vector< OrderBook::LevelDelta > deltas;
+        book.SetDeltaSink( [&deltas]( const OrderBook::LevelDelta& delta ) { deltas.push_back( delta ); } );
+
+        /*
+        sym,  op,   id,  buy/sell side,  price,  vol */
+        book.Insert( 1, Side::SELL, 101,   5 );
+        book.Insert( 2, Side::SELL, 101,   5 );
+        book.Insert( 3, Side::SELL, 102,   5 );
+        book.Insert( 4, Side::SELL, 104,   5 );
+        deltas.clear();
+
+        book.Insert( 10, Side::BUY, 102, 12, OrderBook::kNoOwner, TIF::IOC );
+        ASSERT_EQ( 3, book.GetListOfTrades().size() );
+        ASSERT_EQ( OrderBook::ExecutedTrade( 101, 5, 10, 1, 0 ), book.GetListOfTrades()[0] );
+        ASSERT_EQ( OrderBook::ExecutedTrade( 101, 5, 10, 2, 1 ), book.GetListOfTrades()[1] );
+        ASSERT_EQ( OrderBook::ExecutedTrade( 102, 2, 10, 3, 2 ), book.GetListOfTrades()[2] );
+        ASSERT_EQ( OrderBook::PriceLevel( 0, 0, 102, 3 ), book.GetTopOfBook() );
+        ASSERT_EQ( 2, deltas.size() );  // no delta for the buy side
+        deltas.clear();
+        book.Pull( 10 );
+        ASSERT_TRUE( deltas.empty() );
+
+        // not enough volume up to the limit, nothing happens
+        book.Insert( 11, Side::BUY, 102, 4, OrderBook::kNoOwner, TIF::FOK );
+        ASSERT_EQ( 3, book.GetListOfTrades().size() );
+        ASSERT_TRUE( deltas.empty() );
+
+        book.Insert( 12, Side::BUY, 104, 4, OrderBook::kNoOwner, TIF::FOK );
+        ASSERT_EQ( 5, book.GetListOfTrades().size() );
+        ASSERT_EQ( OrderBook::ExecutedTrade( 104, 1, 12, 4, 4 ), book.GetListOfTrades()[4] );
+        ASSERT_EQ( OrderBook::PriceLevel( 0, 0, 104, 4 ), book.GetTopOfBook() );
+
+        // market orders ignore the price, even one outside the price band
+        book.Insert( 13, Side::SELL, 0, 100, OrderBook::kNoOwner, TIF::MARKET );
+        ASSERT_EQ( 5, book.GetListOfTrades().size() );
+        book.Insert( 14, Side::BUY, 99, 3 );
+        book.Insert( 15, Side::SELL, 0, 10, OrderBook::kNoOwner, TIF::MARKET );
+        ASSERT_EQ( OrderBook::ExecutedTrade( 99, 3, 15, 14, 5 ), book.GetListOfTrades()[5] );
+        ASSERT_EQ( OrderBook::PriceLevel( 0, 0, 104, 4 ), book.GetTopOfBook() );
+
+        book.StartAuction();
+        book.Insert( 16, Side::BUY, 104, 1, OrderBook::kNoOwner, TIF::IOC );
+        book.Uncross();
+        ASSERT_EQ( 6, book.GetListOfTrades().size() );
+        ASSERT_EQ( OrderBook::PriceLevel( 0, 0, 104, 4 ), book.GetTopOfBook() );
+    }
+}
+
+
+TEST(OrderBookTests, ImmediateOrderTradesLikeInsertAndPull)
+{
+    using Side = OrderBook::Side;
+
+    UniqueIDGenerator immediate_id_gen;
+    UniqueIDGenerator pulled_id_gen;
+    OrderBook immediate("GOOG", immediate_id_gen);
+    OrderBook pulled   ("GOOG", pulled_id_gen);
+
+    for( OrderBook* book : { &immediate, &pulled } )
+    {
+        for( size_t id = 1; id <= 20; ++id )
+        {
+            book->Insert( id, id % 2 ? Side::BUY : Side::SELL, id % 2 ? 100.0 - double(id % 7) : 101.0 + double(id % 5), id );
+        }
+    }
+
+    immediate.Insert( 100, Side::BUY,  103.0, 60, OrderBook::kNoOwner, OrderBook::TimeInForce::IOC );
+    immediate.Insert( 101, Side::SELL,  97.0, 70, OrderBook::kNoOwner, OrderBook::TimeInForce::IOC );
+
+    pulled.Insert( 100, Side::BUY,  103.0, 60 );
+    pulled.Pull  ( 100 );
+    pulled.Insert( 101, Side::SELL,  97.0, 70 );
+    pulled.Pull  ( 101 );
+
+    ASSERT_FALSE( immediate.GetListOfTrades().empty() );
+    ASSERT_EQ( pulled.GetListOfTrades(), immediate.GetListOfTrades() );
+    ASSERT_EQ( pulled.GetPriceLevels(), immediate.GetPriceLevels() );
+}
+
+namespace custom_traits
+{
+    struct TickTrade
+    {
+        int64_t  price;
+        uint32_t volume;
+    };
+
+
+    /**
+     * @brief Trade sink without an empty state, so trades are never stored by the order book.
+     */
+    struct CollectTrades
+    {
+        std::vector<TickTrade>* trades;
+
+        template< class Trade >
+        void operator()( const Trade& trade ) const { trades->push_back( TickTrade{ trade.price, trade.volume } ); }
+    };
+
+
+    struct TickTraits
+    {
+        using Price    = int64_t;
+        using OrderId  = uint32_t;
+        using Volume   = uint32_t;
+        using Sequence = uint32_t;
+
+        template< class Level, bool kSell >
+        using Ladder = DensePriceLadder< Level, kSell >;
+
+        template< class Trade >
+        using TradeSink = CollectTrades;
+
+        using Stats = NoOrderBookStats;
+
+        using QueuePositions = QueuePositionIndex;
+    };
+
+
+    struct TinySequenceTraits : TickTraits
+    {
+        using Sequence = uint8_t;  // Runs out after 128 priorities.
+
+        template< class Trade >
+        using TradeSink = std::function< void( const Trade& ) >;
+    };
+
+}
+
+template class BasicOrderBook< custom_traits::TickTraits >;
+using TickOrderBook = BasicOrderBook< custom_traits::TickTraits >;
+template class BasicOrderBook< custom_traits::TinySequenceTraits >;
+using TinySequenceOrderBook = BasicOrderBook< custom_traits::TinySequenceTraits >;
+
+
+TEST(OrderBookTests, CustomTraitsWithIntegerTicks)
+{
+    UniqueIDGenerator id_gen;
+    TickOrderBook book("TICK", id_gen, 1000, 2000);
+
+    std::vector<custom_traits::TickTrade> trades;
+    book.SetTradeSink( custom_traits::CollectTrades{ &trades } );
+
+    book.Insert( 1, TickOrderBook::Side::SELL, 1500, 10 );
+    book.Insert( 2, TickOrderBook::Side::SELL, 1501, 10 );
+    book.Insert( 3, TickOrderBook::Side::BUY,  1499,  5 );
+    ASSERT_EQ( TickOrderBook::PriceLevel( 1499, 5, 1500, 10 ), book.GetTopOfBook() );
+    ASSERT_THROW( book.Insert( 4, TickOrderBook::Side::BUY, 2001, 1 ), std::out_of_range );
+
+    book.Insert( 5, TickOrderBook::Side::BUY, 1501, 15 );
+    ASSERT_EQ( 2, trades.size() );
+    ASSERT_EQ( 1500, trades[0].price );
+    ASSERT_EQ( 10,   trades[0].volume );
+    ASSERT_EQ( 1501, trades[1].price );
+    ASSERT_EQ( 5,    trades[1].volume );
+    ASSERT_TRUE( book.GetListOfTrades().empty() );
+    ASSERT_EQ( TickOrderBook::PriceLevel( 1499, 5, 1501, 5 ), book.GetTopOfBook() );
+
+    book.Amend( 3, 1501, 5 );
+    ASSERT_EQ( 3, trades.size() );
+    ASSERT_EQ( TickOrderBook::PriceLevel(), book.GetTopOfBook() );
+}
+
+
+TEST(OrderBookTests, NarrowSequenceIsRenumberedWhenItRunsOut)
+{
+    UniqueIDGenerator id_gen;
+    TinySequenceOrderBook book("TICK", id_gen, 1000, 2000);
+    using Side = TinySequenceOrderBook::Side;
+
+    book.StartAuction();
+    book.Insert( 1, Side::BUY, 1500, 1 );
+    book.Insert( 2, Side::BUY, 1100, 1 );
+
+    // every amend with more volume takes a new priority
+    for( uint32_t vol = 2; vol < 300; ++vol ) { book.Amend( 2, 1100, vol ); }
+
+    book.Insert( 3, Side::SELL, 1500, 1 );
+    book.Uncross();
+
+    ASSERT_EQ( 1, book.GetListOfTrades().size() );
+    ASSERT_EQ( 3, book.GetListOfTrades()[0].aggressive_order_id );
+    ASSERT_EQ( 1, book.GetListOfTrades()[0].passive_order_id );
+
+    book.Insert( 4, Side::SELL, 1100, 1 );
+    ASSERT_EQ( 2, book.GetListOfTrades().size() );
+    ASSERT_EQ( 4, book.GetListOfTrades()[1].aggressive_order_id );
+    ASSERT_EQ( 2, book.GetListOfTrades()[1].passive_order_id );
+}
+
+
+TEST(OrderBookTests, NarrowSequenceLimitsRestingOrders)
+{
+    UniqueIDGenerator id_gen;
+    TinySequenceOrderBook book("TICK", id_gen, 1000, 2000);
+    using Side = TinySequenceOrderBook::Side;
+
+    constexpr uint32_t kCapacity = TinySequenceOrderBook::kMaxRestingOrders;
+    static_assert( 64 == kCapacity );
+
+    for( uint32_t id = 1; id < kCapacity; ++id ) { book.Insert( id, Side::BUY, 1100, 1 ); }
+    book.Insert( kCapacity, Side::SELL, 1500, 1 );
+    ASSERT_THROW( book.Insert( kCapacity + 1, Side::BUY, 1600, 1 ), std::length_error );
+    ASSERT_TRUE( book.GetListOfTrades().empty() );
+
+    // a full book is renumbered every 64 new priorities, order '1' ends up last at its price
+    for( uint32_t vol = 2; vol < 300; ++vol ) { book.Amend( 1, 1100, vol ); }
+
+    book.Pull( 2 );
+    book.Insert( kCapacity + 1, Side::BUY, 1600, 1 );
+    ASSERT_EQ( 1, book.GetListOfTrades().size() );
+    ASSERT_EQ( 1500,      book.GetListOfTrades()[0].price );
+    ASSERT_EQ( kCapacity, book.GetListOfTrades()[0].passive_order_id );
+
+    book.Insert( kCapacity + 2, Side::SELL, 1100, 1 );
+    ASSERT_EQ( 2, book.GetListOfTrades().size() );
+    ASSERT_EQ( 3, book.GetListOfTrades()[1].passive_order_id );
+}
+
+
+TEST(OrderBookTests, MemoryUsage)
+{
+    UniqueIDGenerator id_gen;
+    OrderBook book("GOOG", id_gen);
+
+    const OrderBook::MemoryUsage empty = book.GetMemoryUsage();
+    ASSERT_EQ( 0, empty.orders );
+    ASSERT_EQ( sizeof(OrderBook), empty.book );
+
+    for( size_t id = 1; id <= 1000; ++id ) { book.Insert( id, OrderBook::Side::BUY, 100.0 + double(id % 50), 10 ); }
+    book.Insert( 1001, OrderBook::Side::SELL, 100.0, 100 );
+
+    const OrderBook::MemoryUsage used = book.GetMemoryUsage();
+    ASSERT_GT( used.orders, 0 );
+    ASSERT_GT( used.order_index, 0 );
+    ASSERT_GT( used.price_levels, 0 );
+    ASSERT_GT( used.trades, 0 );
+    ASSERT_GE( used.arena, used.orders + used.order_index );
+    ASSERT_EQ( used.arena + used.trades + used.book, used.Total() );
+
+    book.Reset();
+    ASSERT_EQ( 0, book.GetMemoryUsage().orders );
+    ASSERT_EQ( 0, book.GetMemoryUsage().order_index );
+    ASSERT_EQ( 0, book.GetMemoryUsage().arena );
+}
+
+
+TEST(OrderBookTests, QueuePositionAndLevelOrders)
+{
+    UniqueIDGenerator id_gen;
+    OrderBook book("GOOG", id_gen);
+    using Side = OrderBook::Side;
+
+    /*
+        sym,  op,   id,  buy/sell side,  price,  vol, owner */
+    book.Insert( 1, Side::BUY,  100,     10,   7 );
+    book.Insert( 2, Side::BUY,  100,     20,   8 );
+    book.Insert( 3, Side::BUY,  100,     30,   7 );
+    book.Insert( 4, Side::BUY,   99,     40,   8 );
+
+    OrderBook::QueuePosition position;
+    ASSERT_FALSE( book.GetQueuePosition( 42, position ) );
+    ASSERT_TRUE( book.GetQueuePosition( 3, position ) );
+    ASSERT_EQ( OrderBook::QueuePosition( Side::BUY, 100, 30, 30, 2 ), position );
+    ASSERT_TRUE( book.GetQueuePosition( 4, position ) );
+    ASSERT_EQ( OrderBook::QueuePosition( Side::BUY, 99, 40, 0, 0 ), position );
+
+    // fills the first order and part of the second
+    book.Insert( 5, Side::SELL, 100, 15 );
+    ASSERT_TRUE( book.GetQueuePosition( 2, position ) );
+    ASSERT_EQ( OrderBook::QueuePosition( Side::BUY, 100, 15, 0, 0 ), position );
+    ASSERT_TRUE( book.GetQueuePosition( 3, position ) );
+    ASSERT_EQ( OrderBook::QueuePosition( Side::BUY, 100, 30, 15, 1 ), position );
+
+    // less volume keeps the place in the queue, more volume goes to the back
+    book.Amend( 2, 100, 5 );
+    ASSERT_TRUE( book.GetQueuePosition( 3, position ) );
+    ASSERT_EQ( OrderBook::QueuePosition( Side::BUY, 100, 30, 5, 1 ), position );
+    book.Amend( 2, 100, 6 );
+    ASSERT_TRUE( book.GetQueuePosition( 2, position ) );
+    ASSERT_EQ( OrderBook::QueuePosition( Side::BUY, 100, 6, 30, 1 ), position );
+
+    const OrderBook::LevelOrders level = book.GetLevelOrders( Side::BUY, 100 );
+    ASSERT_EQ( 36, level.vol );
+    ASSERT_EQ( 2,  level.count );
+    const std::vector<OrderBook::OrderView> orders( level.begin(), level.end() );
+    ASSERT_EQ( ( std::vector<OrderBook::OrderView>{ { 3, 30, 7 }, { 2, 6, 8 } } ), orders );
+
+    ASSERT_TRUE( book.GetLevelOrders( Side::BUY,  98  ).empty() );
+    ASSERT_TRUE( book.GetLevelOrders( Side::SELL, 100 ).empty() );
+
+    std::vector<double> prices;
+    std::vector<OrderBook::OrderId> ids;
+    book.ForEachLevel( Side::BUY, [&]( const OrderBook::LevelOrders& at_price )
+    {
+        prices.push_back( at_price.price );
+        for( const OrderBook::OrderView& order : at_price ) { ids.push_back( order.id ); }
+        return true;
+    } );
+    ASSERT_EQ( ( std::vector<double>{ 100, 99 } ), prices );
+    ASSERT_EQ( ( std::vector<OrderBook::OrderId>{ 3, 2, 4 } ), ids );
+
+    book.Pull( 3 );
+    ASSERT_FALSE( book.GetQueuePosition( 3, position ) );
+    ASSERT_TRUE( book.GetQueuePosition( 2, position ) );
+    ASSERT_EQ( OrderBook::QueuePosition( Side::BUY, 100, 6, 0, 0 ), position );
+}
+
+
+TEST(OrderBookTests, QueuePositionsMatchTheOrdersAhead)
+{
+    // 'OrderBook' walks the orders ahead, 'TickOrderBook' answers from its queue position index
+    static_assert( !DefaultOrderBookTraits::QueuePositions::kEnabled && custom_traits::TickTraits::QueuePositions::kEnabled );
+    auto check = []( auto& book, const auto first_price )
+    {
+        using Book = std::remove_reference_t<decltype(book)>;
+        using Side = typename Book::Side;
+
+        std::mt19937_64 rng( 3 );
+        std::vector<uint32_t> ids;
+
+        for( uint32_t id = 1; id <= 5000; ++id )
+        {
+            const Side side  = rng() % 2 ? Side::BUY : Side::SELL;
+            const auto price = first_price + ( Side::BUY == side ? 0 : 4 ) + decltype(first_price)( rng() % 4 );
+
+            switch( rng() % 4 )
+            {
+                case 0:  book.Insert( id, side, price, uint32_t( 1 + rng() % 9 ) ); ids.push_back( id ); break;
+                case 1:  if( !ids.empty() ) { book.Pull( ids[ rng() % ids.size() ] ); } break;
+                case 2:  if( !ids.empty() ) { book.Amend( ids[ rng() % ids.size() ], price, uint32_t( 1 + rng() % 9 ) ); } break;
+                default: book.Insert( id, side, first_price + 4 - ( Side::BUY == side ? 1 : 0 ), 5 ); ids.push_back( id ); break;
+            }
+        }
+
+        size_t checked = 0;
+        for( const Side side : { Side::BUY, Side::SELL } )
+        {
+            book.ForEachLevel( side, [&]( const typename Book::LevelOrders& level )
+            {
+                uint64_t volume_ahead = 0;
+                size_t   orders_ahead = 0;
+
+                for( const typename Book::OrderView& order : level )
+                {
+                    typename Book::QueuePosition position;
+                    EXPECT_TRUE( book.GetQueuePosition( order.id, position ) );
+                    EXPECT_EQ( typename Book::QueuePosition( side, level.price, order.vol, typename Book::Volume( volume_ahead ), orders_ahead ), position );
+
+                    volume_ahead += order.vol;
+                    ++orders_ahead;
+                    ++checked;
+                }
+
+                EXPECT_EQ( level.vol,   volume_ahead );
+                EXPECT_EQ( level.count, orders_ahead );
+                return true;
+            } );
+        }
+
+        return checked;
+    };
+
+    UniqueIDGenerator id_gen;
+    OrderBook     book("GOOG", id_gen);
+    TickOrderBook tick_book("TICK", id_gen, 1000, 2000);
+
+    std::vector<custom_traits::TickTrade> trades;
+    tick_book.SetTradeSink( custom_traits::CollectTrades{ &trades } );
+
+    const size_t resting = check( book, 100.0 );
+    ASSERT_GT( resting, 100 );
+    ASSERT_EQ( resting, check( tick_book, int64_t(1500) ) );
+}
+
+
+TEST(OrderBookTests, TradeSummaryAndBars)
+{
+    UniqueIDGenerator id_gen;
+    OrderBook book("GOOG", id_gen);
+    using Side = OrderBook::Side;
+
+    uint64_t now = 60'000'000'000;
+    book.SetTradeBars( 60'000'000'000, 2, [&now] { return now; } );
+    ASSERT_EQ( OrderBook::TradeSummary{}, book.GetTradeSummary() );
+
+    /*
+        sym,  op,   id,  buy/sell side,  price,  vol */
+    book.Insert( 1, Side::SELL, 100.5,   10 );
+    book.Insert( 2, Side::SELL, 101.0,   10 );
+    book.Insert( 3, Side::BUY,  101.0,   15 );  // two trades
+
+    const OrderBook::TradeSummary first = book.GetTradeSummary();
+    ASSERT_EQ( 100.5, first.open );
+    ASSERT_EQ( 101.0, first.high );
+    ASSERT_EQ( 100.5, first.low );
+    ASSERT_EQ( 101.0, first.last );
+    ASSERT_EQ( 15, first.volume );
+    ASSERT_EQ( 2,  first.trades );
+    ASSERT_DOUBLE_EQ( 100.5 * 10 + 101.0 * 5, first.notional );
+    ASSERT_DOUBLE_EQ( first.notional / 15, first.vwap );
+
+    // trades going to a sink count as well, as do immediate orders
+    std::vector<OrderBook::ExecutedTrade> trades;
+    book.SetTradeSink( [&trades]( const OrderBook::ExecutedTrade& trade ) { trades.push_back( trade ); } );
+
+    now += 60'000'000'000;
+    book.Insert( 4, Side::BUY,  102.0, 50 );
+    book.Insert( 5, Side::SELL,  99.0,  5, OrderBook::kNoOwner, OrderBook::TimeInForce::IOC );
+    ASSERT_EQ( 2, trades.size() );
+    ASSERT_EQ( 4, book.GetTradeSummary().trades );
+    ASSERT_EQ( 100.5, book.GetTradeSummary().low );
+    ASSERT_EQ( 102.0, book.GetTradeSummary().last );
+
+    std::array<OrderBook::TradeBar, 3> bars;
+    ASSERT_EQ( 2, book.GetTradeBars( bars ) );
+    ASSERT_EQ( ( OrderBook::TradeBar{  60'000'000'000, 100.5, 101.0, 100.5, 101.0, 15, 2 } ), bars[0] );
+    ASSERT_EQ( ( OrderBook::TradeBar{ 120'000'000'000, 101.0, 102.0, 101.0, 102.0, 10, 2 } ), bars[1] );
+
+    // too little room keeps the newest bars
+    ASSERT_EQ( 1, book.GetTradeBars( std::span<OrderBook::TradeBar>( bars.data(), 1 ) ) );
+    ASSERT_EQ( 120'000'000'000, bars[0].start );
+
+    book.Reset();
+    ASSERT_EQ( OrderBook::TradeSummary{}, book.GetTradeSummary() );
+    ASSERT_EQ( 0, book.GetTradeBars( bars ) );
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "OrderFlowReplayer.h"
+
+namespace
+{
+    std::string CapturePath( const std::string& name )
+    {
+        const auto path = std::filesystem::temp_directory_path() / ( "OrderBookTests_" + name + ".capture" );
+        std::filesystem::remove( path );
+        return path.string();
+    }
+
+
+    const char* kReadmeCapture =
+        "# sym, op, id, side, price, vol\n"
+        "GOOG, INSERT, 1, BUY,  145.3,  17\n"
+        "TSLA, INSERT, 2, SELL, 201.2, 121\n"
+        "TSLA, INSERT, 3, SELL, 205.5,  68\n"
+        "GOOG, INSERT, 4, BUY,  136.1,  12\n"
+        "TSLA, INSERT, 5, SELL, 205.5, 205\n"
+        "\n"
+        "TSLA, INSERT, 6, SELL, 206.9,  41\n"
+        "GOOG, INSERT, 7, SELL, 146.2, 130\n"
+        "GOOG, AMEND,  4,     , 147.0,  50\n"
+        "TSLA, PULL,   6\n"
+        "TSLA, AMEND,  3,     , 205.5,  75\r\n"
+        "TSLA, INSERT, 8, BUY,  209.8, 300";
+}
+
+
+TEST(OrderFlowReplayerTests, ReplaysReadmeExample)
+{
+    const std::string path = CapturePath( "Readme" );
+    std::ofstream( path ) << kReadmeCapture;
+
+    UniqueIDGenerator id_gen;
+    OrderFlowReplayer replayer( id_gen, 2 );
+    const OrderFlowReplayer::Result result = replayer.Replay( path, OrderFlowReplayer::Format::TEXT );
+
+    ASSERT_EQ( 11, result.commands );
+    ASSERT_EQ( 0,  result.rejected );
+    ASSERT_EQ( 2,  result.symbols.size() );
+    ASSERT_EQ( "GOOG", result.symbols[0].symbol );
+    ASSERT_EQ( 1,   result.symbols[0].trades );
+    ASSERT_EQ( 50,  result.symbols[0].traded_volume );
+    ASSERT_EQ( 2,   result.symbols[1].trades );
+    ASSERT_EQ( 300, result.symbols[1].traded_volume );
+
+    ASSERT_EQ( std::vector<OrderBook::PriceLevel>({ { 145.3, 17, 146.2, 80 } }), replayer.GetBook( "GOOG" )->GetPriceLevels() );
+    ASSERT_EQ( std::vector<OrderBook::PriceLevel>({ { 0, 0, 205.5, 101 } }),     replayer.GetBook( "TSLA" )->GetPriceLevels() );
+    ASSERT_EQ( nullptr, replayer.GetBook( "MSFT" ) );
+}
+
+
+TEST(OrderFlowReplayerTests, ParallelReplayMatchesSequentialApply)
+{
+    // enough messages for several chunks, spread over more symbols than threads
+    const std::string text_path   = CapturePath( "Parallel" );
+    const std::string binary_path = CapturePath( "ParallelBinary" );
+    const char* symbols[] = { "AAPL", "AMZN", "GOOG", "META", "MSFT", "NVDA", "TSLA" };
+
+    std::mt19937_64 rng( 11 );
+    std::vector< std::vector<OrderBook::Command> > expected( std::size( symbols ) );
+    {
+        std::ofstream file( text_path );
+        for( size_t id = 1; id <= 400000; ++id )
+        {
+            const size_t s = rng() % std::size( symbols );
+            const bool   pull = id > 10 && 0 == rng() % 4;
+            const size_t target = pull ? id - 1 - rng() % 10 : id;
+            const bool   sell = rng() % 2;
+            const double price = 100.0 + double( rng() % 21 ) - 10.0;
+            const size_t vol = 1 + rng() % 50;
+
+            if( pull )
+            {
+                file << symbols[s] << ", PULL, " << target << "\n";
+                expected[s].push_back( OrderBook::Command{ OrderBook::Command::Type::PULL, OrderBook::Side::BUY, target, 0.0, 0 } );
+            }
+            else
+            {
+                file << symbols[s] << ", INSERT, " << id << ", " << ( sell ? "SELL" : "BUY" ) << ", " << price << ", " << vol << "\n";
+                expected[s].push_back( OrderBook::Command{ OrderBook::Command::Type::INSERT, sell ? OrderBook::Side::SELL : OrderBook::Side::BUY, id, price, vol } );
+            }
+        }
+    }
+
+    ASSERT_EQ( 400000, OrderFlowReplayer::ConvertToBinary( text_path, binary_path ) );
+
+    for( const auto format : { OrderFlowReplayer::Format::TEXT, OrderFlowReplayer::Format::BINARY } )
+    {
+        UniqueIDGenerator id_gen;
+        OrderFlowReplayer replayer( id_gen, 3 );
+        const OrderFlowReplayer::Result result = replayer.Replay( format == OrderFlowReplayer::Format::TEXT ? text_path : binary_path, format );
+        ASSERT_EQ( 400000, result.commands );
+
+        for( size_t s = 0; s < std::size( symbols ); ++s )
+        {
+            UniqueIDGenerator sequential_id_gen;
+            OrderBook book( symbols[s], sequential_id_gen );
+            for( const auto& command : expected[s] ) { book.Apply( command ); }
+
+            ASSERT_EQ( book.GetPriceLevels(), replayer.GetBook( symbols[s] )->GetPriceLevels() );
+            ASSERT_EQ( book.GetListOfTrades().size(), result.symbols[s].trades );
+        }
+    }
+}
+
+
+TEST(OrderFlowReplayerTests, MalformedCaptureThrows)
+{
+    const std::string path = CapturePath( "Malformed" );
+    std::ofstream( path ) << "GOOG, INSERT, 1, BUY, 145.3, 17\nGOOG, INSERT, 2, BUY, abc, 17\n";
+
+    UniqueIDGenerator id_gen;
+    OrderFlowReplayer replayer( id_gen, 2 );
+    ASSERT_THROW( replayer.Replay( path, OrderFlowReplayer::Format::TEXT ), std::invalid_argument );
+    ASSERT_THROW( replayer.Replay( path, OrderFlowReplayer::Format::BINARY ), std::invalid_argument );
+}
+
+
+TEST(OrderFlowReplayerTests, FactoryExceptionThrows)
+{
+    const std::string path = CapturePath( "Factory" );
+    std::ofstream( path ) << kReadmeCapture;
+
+    // whichever thread the symbol is routed to, the exception reaches the caller
+    for( const size_t threads : { 1, 2, 3, 4 } )
+    {
+        UniqueIDGenerator id_gen;
+        OrderFlowReplayer replayer( id_gen, threads, []( const std::string_view symbol, UniqueIDGenerator& id_gen )
+        {
+            if( "TSLA" == symbol ) { throw std::invalid_argument( "no such symbol" ); }
+            return std::make_unique<OrderBook>( std::string( symbol ), id_gen );
+        } );
+
+        ASSERT_THROW( replayer.Replay( path, OrderFlowReplayer::Format::TEXT ), std::invalid_argument );
+        ASSERT_EQ( nullptr, replayer.GetBook( "TSLA" ) );
+    }
+    std::filesystem::remove( path );
+}
+
+
+TEST(OrderFlowReplayerTests, SkipsLeadingHeaderLine)
+{
+    const std::string path = CapturePath( "Header" );
+    std::ofstream( path ) << "sym, op, id, side, price, vol\nGOOG, INSERT, 1, BUY, 145.3, 17\n";
+
+    UniqueIDGenerator id_gen;
+    OrderFlowReplayer replayer( id_gen, 2 );
+    ASSERT_EQ( 1, replayer.Replay( path, OrderFlowReplayer::Format::TEXT ).commands );
+    ASSERT_EQ( std::vector<OrderBook::PriceLevel>({ { 145.3, 17, 0, 0 } }), replayer.GetBook( "GOOG" )->GetPriceLevels() );
+
+    const std::string binary_path = CapturePath( "HeaderBinary" );
+    ASSERT_EQ( 1, OrderFlowReplayer::ConvertToBinary( path, binary_path ) );
+    std::filesystem::remove( binary_path );
+
+    // only the first line may be a header
+    std::ofstream( path ) << "GOOG, INSERT, 1, BUY, 145.3, 17\nsym, op, id, side, price, vol\n";
+    ASSERT_THROW( replayer.Replay( path, OrderFlowReplayer::Format::TEXT ), std::invalid_argument );
+    std::filesystem::remove( path );
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+
+#include "OrderIndex.h"
+
+TEST(OrderIndexTests, InsertFindErase)
+{
+    OrderIndex index;
+    ASSERT_EQ( OrderIndex::kNil, index.Find( 1 ) );
+    ASSERT_FALSE( index.Erase( 1 ) );
+
+    ASSERT_TRUE( index.Insert( 1, 10 ) );
+    ASSERT_TRUE( index.Insert( 2, 20 ) );
+    ASSERT_FALSE( index.Insert( 1, 30 ) );  // Already present, keeps the first handle.
+    ASSERT_EQ( 2, index.Size() );
+    ASSERT_EQ( 10, index.Find( 1 ) );
+    ASSERT_EQ( 20, index.Find( 2 ) );
+
+    ASSERT_TRUE( index.Erase( 1 ) );
+    ASSERT_EQ( OrderIndex::kNil, index.Find( 1 ) );
+    ASSERT_EQ( 20, index.Find( 2 ) );
+    ASSERT_EQ( 1, index.Size() );
+}
+
+
+TEST(OrderIndexTests, ReserveAvoidsRehash)
+{
+    OrderIndex index;
+    index.Reserve( 1000 );
+    const size_t capacity = index.Capacity();
+    ASSERT_GE( capacity, 1000 );
+
+    for( size_t id = 0; id < 1000; ++id )
+    {
+        index.Insert( id, OrderIndex::Handle(id) );
+    }
+
+    ASSERT_EQ( capacity, index.Capacity() );
+}
+
+
+TEST(OrderIndexTests, MatchesUnorderedMapUnderChurn)
+{
+    // erasing shifts entries back, which must keep every other entry reachable
+    OrderIndex index;
+    std::unordered_map<size_t, OrderIndex::Handle> reference;
+    std::mt19937_64 rng( 7 );
+
+    for( size_t i = 0; i < 200000; ++i )
+    {
+        // mostly dense ids, some with a large stride
+        const size_t id = rng() % 4 ? rng() % 5000 : ( rng() % 64 ) << 32;
+
+        if( rng() % 2 )
+        {
+            ASSERT_EQ( reference.insert( { id, OrderIndex::Handle(i) } ).second, index.Insert( id, OrderIndex::Handle(i) ) );
+        }
+        else
+        {
+            ASSERT_EQ( 1 == reference.erase( id ), index.Erase( id ) );
+        }
+    }
+
+    ASSERT_EQ( reference.size(), index.Size() );
+    for( size_t id = 0; id < 5000; ++id )
+    {
+        auto it = reference.find( id );
+        ASSERT_EQ( it == reference.end() ? OrderIndex::kNil : it->second, index.Find( id ) );
+    }
+    for( const auto& [id, handle] : reference )
+    {
+        ASSERT_EQ( handle, index.Find( id ) );
+    }
+
+    index.Release();
+    ASSERT_TRUE( index.Empty() );
+    ASSERT_EQ( OrderIndex::kNil, index.Find( 1 ) );
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "QueuePositionIndex.h"
+
+TEST(QueuePositionIndexTests, AppendReduceRemove)
+{
+    QueuePositionIndex index;
+    ASSERT_EQ( 0, index.Append( 10 ) );
+    ASSERT_EQ( 1, index.Append( 20 ) );
+    ASSERT_EQ( 2, index.Append( 30 ) );
+    ASSERT_EQ( 3, index.Slots() );
+
+    ASSERT_EQ( ( QueueAhead{  0, 0 } ), index.Ahead( 0 ) );
+    ASSERT_EQ( ( QueueAhead{ 30, 2 } ), index.Ahead( 2 ) );
+    ASSERT_EQ( ( QueueAhead{ 60, 3 } ), index.Ahead( 3 ) );
+
+    index.Reduce( 0, 4 );
+    ASSERT_EQ( ( QueueAhead{ 26, 2 } ), index.Ahead( 2 ) );
+
+    index.Remove( 1, 20 );
+    ASSERT_EQ( ( QueueAhead{ 6, 1 } ), index.Ahead( 2 ) );
+    ASSERT_EQ( 3, index.Slots() );
+
+    index.Clear();
+    ASSERT_EQ( 0, index.Slots() );
+    ASSERT_EQ( 0, index.Append( 5 ) );
+}
+
+
+TEST(QueuePositionIndexTests, MatchesPrefixSums)
+{
+    std::mt19937_64 rng( 11 );
+    QueuePositionIndex index;
+    std::vector<uint64_t> vols;     // Volume of every slot, 0 once removed.
+    std::vector<uint64_t> present;  // 1 for every slot holding an order.
+
+    for( size_t i = 0; i < 5000; ++i )
+    {
+        const size_t op = rng() % 4;
+        if( vols.empty() || 0 == op )
+        {
+            const uint64_t vol = 1 + rng() % 100;
+            ASSERT_EQ( vols.size(), index.Append( vol ) );
+            vols.push_back( vol );
+            present.push_back( 1 );
+        }
+        else
+        {
+            const size_t slot = rng() % vols.size();
+            if( 0 == present[slot] ) { continue; }
+
+            if( 1 == op && vols[slot] > 1 )
+            {
+                index.Reduce( uint32_t(slot), 1 );
+                vols[slot] -= 1;
+            }
+            else if( 2 == op )
+            {
+                index.Remove( uint32_t(slot), vols[slot] );
+                vols[slot]    = 0;
+                present[slot] = 0;
+            }
+        }
+
+        const size_t probe = rng() % ( vols.size() + 1 );
+        QueueAhead expected;
+        for( size_t s = 0; s < probe; ++s )
+        {
+            expected.volume += vols[s];
+            expected.orders += present[s];
+        }
+        ASSERT_EQ( expected, index.Ahead( uint32_t(probe) ) );
+    }
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "OrderBook.h"
+#include "SpscRingBuffer.h"
+
+TEST(SpscRingBufferTests, PushPopAndFull)
+{
+    SpscRingBuffer<int> ring(3);
+    ASSERT_EQ( 4, ring.Capacity() );
+
+    for( int i = 0; i < 4; ++i )
+    {
+        ASSERT_TRUE( ring.TryPush( i ) );
+    }
+    ASSERT_FALSE( ring.TryPush( 4 ) );
+    ASSERT_EQ( 4, ring.Size() );
+
+    int value = -1;
+    for( int i = 0; i < 4; ++i )
+    {
+        ASSERT_TRUE( ring.TryPop( value ) );
+        ASSERT_EQ( i, value );
+    }
+    ASSERT_FALSE( ring.TryPop( value ) );
+}
+
+
+TEST(SpscRingBufferTests, TradesStreamToConsumerThread)
+{
+    constexpr size_t kOrders = 10000;
+
+    UniqueIDGenerator id_gen;
+    OrderBook book("MSFT", id_gen);
+    SpscRingBuffer<OrderBook::ExecutedTrade> ring(64);
+
+    book.SetTradeSink( [&ring]( const OrderBook::ExecutedTrade& trade )
+    {
+        while( !ring.TryPush( trade ) ) {}
+    } );
+
+    size_t traded_vol = 0;
+    size_t trades     = 0;
+    std::thread consumer( [&]
+    {
+        OrderBook::ExecutedTrade trade;
+        while( trades < kOrders )
+        {
+            if( ring.TryPop( trade ) )
+            {
+                EXPECT_EQ( trades, trade.trade_id );
+                traded_vol += trade.volume;
+                ++trades;
+            }
+        }
+    } );
+
+    for( size_t i = 0; i < kOrders; ++i )
+    {
+        book.Insert( 2*i,   OrderBook::Side::SELL, 10.0, 2 );
+        book.Insert( 2*i+1, OrderBook::Side::BUY,  10.0, 2 );
+    }
+
+    consumer.join();
+    ASSERT_EQ( 2*kOrders, traded_vol );
+    ASSERT_EQ( 0, book.GetListOfTrades().size() );
+}
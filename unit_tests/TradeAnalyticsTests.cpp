@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "TradeAnalytics.h"
+
+TEST(TradeAnalyticsTests, Totals)
+{
+    TradeAnalytics analytics;
+    ASSERT_EQ( 0, analytics.Totals().trades );
+    ASSERT_FALSE( analytics.HasBars() );
+
+    analytics.Record( 100, 10, 0 );
+    analytics.Record( 103,  5, 0 );
+    analytics.Record(  98,  1, 0 );
+    analytics.Record( 101,  4, 0 );
+
+    ASSERT_EQ( ( TickBar{ 0, 100, 103, 98, 101, 20, 4 } ), analytics.Totals() );
+    ASSERT_EQ( 100.0 * 10 + 103.0 * 5 + 98.0 + 101.0 * 4, analytics.Notional() );
+    ASSERT_EQ( 0, analytics.BarCount() );
+
+    analytics.Clear();
+    ASSERT_EQ( TickBar{}, analytics.Totals() );
+    ASSERT_EQ( 0, analytics.Notional() );
+}
+
+
+TEST(TradeAnalyticsTests, BarsWrapAround)
+{
+    TradeAnalytics analytics;
+    analytics.SetBars( 10, 3 );
+    ASSERT_TRUE( analytics.HasBars() );
+
+    analytics.Record( 100, 1,  5 );
+    analytics.Record( 102, 2,  9 );
+    analytics.Record( 101, 3, 25 );  // skips the interval starting at 10
+    ASSERT_EQ( 2, analytics.BarCount() );
+    ASSERT_EQ( ( TickBar{  0, 100, 102, 100, 102, 3, 2 } ), analytics.Bar( 0 ) );
+    ASSERT_EQ( ( TickBar{ 20, 101, 101, 101, 101, 3, 1 } ), analytics.Bar( 1 ) );
+
+    // a time before the current bar is counted in the current bar
+    analytics.Record( 99, 1, 3 );
+    ASSERT_EQ( 2, analytics.BarCount() );
+    ASSERT_EQ( ( TickBar{ 20, 101, 101, 99, 99, 4, 2 } ), analytics.Bar( 1 ) );
+
+    analytics.Record( 105, 1, 30 );
+    analytics.Record( 106, 1, 40 );
+    ASSERT_EQ( 3, analytics.BarCount() );
+    ASSERT_EQ( 20, analytics.Bar( 0 ).start );
+    ASSERT_EQ( 30, analytics.Bar( 1 ).start );
+    ASSERT_EQ( 40, analytics.Bar( 2 ).start );
+
+    analytics.Clear();
+    ASSERT_TRUE( analytics.HasBars() );
+    ASSERT_EQ( 0, analytics.BarCount() );
+
+    analytics.SetBars( 10, 0 );
+    ASSERT_FALSE( analytics.HasBars() );
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "OrderBook.h"
+#include "UniqueIDGenerator.h"
+
+TEST(UniqueIDGeneratorTests, CounterHasItsOwnCacheLine)
+{
+    ASSERT_EQ( 64, alignof(UniqueIDGenerator) );
+    ASSERT_EQ( 64, sizeof(UniqueIDGenerator) );
+}
+
+
+TEST(UniqueIDGeneratorTests, LeasesHandOutUniqueIDsAcrossThreads)
+{
+    constexpr size_t kThreads = 4;
+    constexpr size_t kIDs     = 10000;
+
+    UniqueIDGenerator id_gen;
+    std::vector< std::vector<size_t> > ids( kThreads );
+    std::vector< std::thread > threads;
+
+    for( size_t t = 0; t < kThreads; ++t )
+    {
+        threads.emplace_back( [&id_gen, &ids, t]
+        {
+            IDBlockLease lease( id_gen, 64 );
+            for( size_t i = 0; i < kIDs; ++i ) { ids[t].push_back( lease.GenerateID() ); }
+        } );
+    }
+
+    for( auto& thread : threads ) { thread.join(); }
+
+    std::vector<size_t> all;
+    for( auto& thread_ids : ids )
+    {
+        ASSERT_TRUE( std::is_sorted( thread_ids.begin(), thread_ids.end() ) );
+        all.insert( all.end(), thread_ids.begin(), thread_ids.end() );
+    }
+
+    std::sort( all.begin(), all.end() );
+    ASSERT_EQ( all.end(), std::adjacent_find( all.begin(), all.end() ) );
+}
+
+
+TEST(UniqueIDGeneratorTests, ResetNeverRepeatsLeasedIDs)
+{
+    UniqueIDGenerator id_gen;
+    IDBlockLease lease( id_gen, 10 );
+
+    ASSERT_EQ( 0, lease.GenerateID() );
+    ASSERT_EQ( 1, lease.GenerateID() );
+
+    id_gen.Reset();
+    ASSERT_EQ( 1, id_gen.GetEpoch() );
+    ASSERT_EQ( size_t(1) << UniqueIDGenerator::kEpochShift, id_gen.GenerateID() );
+
+    ASSERT_EQ( 2, lease.GenerateID() );  // Rest of the block leased before the reset stays valid.
+}
+
+
+TEST(UniqueIDGeneratorTests, OrderBookTradeIDBlocks)
+{
+    UniqueIDGenerator id_gen;
+    OrderBook goog("GOOG", id_gen);
+    OrderBook tsla("TSLA", id_gen);
+    goog.SetTradeIDBlockSize( 100 );
+    tsla.SetTradeIDBlockSize( 100 );
+
+    goog.Insert( 1, OrderBook::Side::BUY,  10.0, 1 );
+    goog.Insert( 2, OrderBook::Side::SELL, 10.0, 1 );
+    tsla.Insert( 1, OrderBook::Side::BUY,  10.0, 1 );
+    tsla.Insert( 2, OrderBook::Side::SELL, 10.0, 1 );
+    goog.Insert( 3, OrderBook::Side::BUY,  10.0, 1 );
+    goog.Insert( 4, OrderBook::Side::SELL, 10.0, 1 );
+
+    ASSERT_EQ(   0, goog.GetListOfTrades()[0].trade_id );
+    ASSERT_EQ(   1, goog.GetListOfTrades()[1].trade_id );
+    ASSERT_EQ( 100, tsla.GetListOfTrades()[0].trade_id );
+}